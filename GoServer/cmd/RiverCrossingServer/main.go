@@ -37,6 +37,7 @@ http://localhost:8080/RiverCrossing
 package main
 
 import (
+	"bufio"
 	"errors"
 	"fmt"
 	"html/template"
@@ -235,12 +236,12 @@ Any other case should provide a non-nil err.
 func callSolver(inputReader io.Reader, interactive bool) (out string, solved bool, err error) {
 	out, solved, err = "", true, nil
 
-	cmdArg := "interactive"
-	if !interactive {
-		cmdArg = ""
+	var cmdArgs []string
+	if interactive {
+		cmdArgs = append(cmdArgs, "interactive")
 	}
 
-	cmd := exec.Command(solverPath, cmdArg)
+	cmd := exec.Command(solverPath, cmdArgs...)
 	cmd.Stdin = inputReader
 
 	var combinedOutput []byte
@@ -322,12 +323,160 @@ func callSolver(inputReader io.Reader, interactive bool) (out string, solved boo
 	return
 }
 
+/*
+A solver launched with the `serve` argument, which handles several requests
+within the same process, instead of launching a new solver for each request.
+The solver treats one scenario at a time, so each daemon is used by a single
+request at a time (see solverPool).
+*/
+type solverDaemon struct {
+	cmd    *exec.Cmd
+	input  io.WriteCloser
+	output *bufio.Reader
+}
+
+// Longest time a daemon may spend on a request before being killed
+const solverTimeout = 5 * time.Minute
+
+// Launches the solver in serving mode, reusing the outcomes of the scenarios
+// explored before, which are kept next to the solver
+func (d *solverDaemon) start() error {
+	cacheDir := filepath.Join(filepath.Dir(solverPath), "SolutionsCache")
+	cmd := exec.Command(solverPath, "serve", "cache="+cacheDir)
+	cmd.Stderr = os.Stderr // for the errors outside any request
+	input, err := cmd.StdinPipe()
+	if err != nil {
+		return err
+	}
+	output, err := cmd.StdoutPipe()
+	if err != nil {
+		return err
+	}
+	if err = cmd.Start(); err != nil {
+		return err
+	}
+	d.cmd, d.input, d.output = cmd, input, bufio.NewReader(output)
+	return nil
+}
+
+// Terminates the solver after a failed exchange
+func (d *solverDaemon) stop() {
+	d.input.Close()
+	d.cmd.Process.Kill()
+	d.cmd.Wait()
+	d.cmd = nil
+}
+
+/*
+Sends the scenario as a request frame to the solver and reads the result frame.
+
+The request frame is a header line with the size of the scenario in bytes
+(followed by " interactive" if needed) and then the scenario.
+The result frame is a header line with the exit code of the solver for
+the scenario (0 or -1) and the size of the output in bytes, then the output.
+
+The solver gets killed when the exchange takes longer than solverTimeout,
+which makes the pending write / read fail.
+*/
+func (d *solverDaemon) exchange(input string, interactive bool) (out string, exitCode int, timedOut bool, err error) {
+	cmd := d.cmd
+	timer := time.AfterFunc(solverTimeout, func() { cmd.Process.Kill() })
+	defer func() {
+		timedOut = !timer.Stop()
+	}()
+
+	header := fmt.Sprint(len(input))
+	if interactive {
+		header += " interactive"
+	}
+	if _, err = io.WriteString(d.input, header+"\n"+input); err != nil {
+		return
+	}
+
+	var line string
+	if line, err = d.output.ReadString('\n'); err != nil {
+		return
+	}
+	var size int
+	if _, err = fmt.Sscan(line, &exitCode, &size); err != nil {
+		return
+	}
+	buf := make([]byte, size)
+	if _, err = io.ReadFull(d.output, buf); err != nil {
+		return
+	}
+	out = string(buf)
+	return
+}
+
+/*
+Solves the scenario with the solver daemon, (re)launching it when necessary.
+
+When the daemon exceeds solverTimeout, it is killed and the request fails.
+When the daemon fails otherwise, the scenario is handed to callSolver,
+which launches a dedicated solver able to report the cause of the failure.
+In both cases, the daemon is relaunched for its next request.
+*/
+func (d *solverDaemon) solve(input string, interactive bool) (out string, solved bool, err error) {
+	if d.cmd == nil {
+		err = d.start()
+	}
+	if err == nil {
+		var exitCode int
+		var timedOut bool
+		out, exitCode, timedOut, err = d.exchange(input, interactive)
+		if err == nil && !timedOut {
+			solved = exitCode == 0
+			out = adaptAsHtmlOutput(out)
+			return
+		}
+		d.stop()
+		if timedOut {
+			out = fmt.Sprint("The solver couldn't handle the scenario within ",
+				solverTimeout, "!")
+			err = errors.New(out)
+			return
+		}
+	}
+
+	return callSolver(strings.NewReader(input), interactive)
+}
+
+/*
+The idle solver daemons, which are launched on their first request.
+Their count is limited by the available cores, as each one may keep a core busy.
+When all of them are busy, the request is handed to callSolver instead of
+waiting for a daemon.
+*/
+type solverPool struct {
+	idle chan *solverDaemon
+}
+
+func newSolverPool(size int) *solverPool {
+	p := &solverPool{idle: make(chan *solverDaemon, size)}
+	for i := 0; i < size; i++ {
+		p.idle <- &solverDaemon{}
+	}
+	return p
+}
+
+func (p *solverPool) solve(input string, interactive bool) (out string, solved bool, err error) {
+	select {
+	case d := <-p.idle:
+		defer func() { p.idle <- d }()
+		return d.solve(input, interactive)
+	default:
+		return callSolver(strings.NewReader(input), interactive)
+	}
+}
+
+var daemons = newSolverPool(min(runtime.NumCPU(), 4))
+
 func post(r *http.Request) (tmpl, out string) {
 	input := r.FormValue("scenarioData")
-	inputReader := strings.NewReader(input)
 	interactive := r.FormValue("interactiveSol") == "on"
 	var solved bool
-	out, solved, _ = callSolver(inputReader, interactive)
+	out, solved, _ = daemons.solve(input, interactive)
 
 	if solved {
 		if interactive {
@@ -16,11 +16,33 @@
 #include "entitiesManager.h"
 
 #include <climits>
+#include <numeric>
 #include <optional>
+#include <unordered_set>
 
 namespace rc::cond {
 
-class IConfigConstraint;  // forward declaration
+// Forward declarations
+class IConfigConstraint;
+class ExprProgram;
+
+/// Max period of the `CrossingIndex`-dependent expressions worth tabulating
+constexpr unsigned MaxCrossingIndexPeriod{64U};
+
+/**
+  @return the common period of 2 periodic values or nothing when any of them
+  isn't periodic or when the common period exceeds MaxCrossingIndexPeriod
+*/
+[[nodiscard]] inline std::optional<unsigned> commonPeriod(
+    const std::optional<unsigned>& p1,
+    const std::optional<unsigned>& p2) noexcept {
+  if (!p1 || !p2)
+    return {};
+  const unsigned p{std::lcm(*p1, *p2)};
+  if (p > MaxCrossingIndexPeriod)
+    return {};
+  return p;
+}
 
 /// Allows an extension of the validation of IConfigConstraint
 class IConfigConstraintValidatorExt {
@@ -100,6 +122,10 @@ class IConfigConstraint {
   /// @return the length of the longest possible mismatch
   virtual unsigned longestMismatchLength() const noexcept { return UINT_MAX; }
 
+  /// Adds to `ids` the ids of the entities mentioned individually
+  virtual void addMentionedIdsTo(
+      std::unordered_set<unsigned>& /*ids*/) const {}
+
   /// Describes the constraint
   virtual std::string toString() const = 0;
 
@@ -137,6 +163,28 @@ class AbsExpr {
   */
   virtual Type eval(const SymbolsTable& st) const = 0;
 
+  /**
+    Appends to `program` the instructions computing this expression
+    @return false when the expression can be evaluated only as a tree
+  */
+  virtual bool lowerTo(ExprProgram& /*program*/) const { return false; }
+
+  /**
+    @return the period of the values of the expression as a function of
+    `CrossingIndex` (1 for constants) or nothing when the expression depends
+    on other variables or its periodicity isn't evident
+  */
+  virtual std::optional<unsigned> crossingIndexPeriod() const noexcept {
+    if (val)
+      return 1U;
+    return {};
+  }
+
+  /// @return c when the expression is `CrossingIndex + c`; otherwise nothing
+  virtual std::optional<double> crossingIndexOffset() const noexcept {
+    return {};
+  }
+
   virtual std::string toString() const = 0;
 
  protected:
@@ -200,6 +248,26 @@ class IValues {
   /// table
   virtual bool contains(const Type& v, const SymbolsTable& st = {}) const = 0;
 
+  /**
+    Appends to `program` the instructions replacing the value from the top of
+    its stack with the outcome of `contains` for that value
+    @return false when the values can be checked only as a tree
+  */
+  virtual bool lowerContainsTo(ExprProgram& /*program*/) const {
+    return false;
+  }
+
+  /**
+    @return the period of the values as a function of `CrossingIndex`
+    (1 for constant sets) or nothing when they depend on other variables or
+    their periodicity isn't evident
+  */
+  virtual std::optional<unsigned> crossingIndexPeriod() const noexcept {
+    if (constSet())
+      return 1U;
+    return {};
+  }
+
   virtual std::string toString() const = 0;
 
  protected:
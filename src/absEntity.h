@@ -16,6 +16,7 @@
 #include "symbolsTable.h"
 
 #include <iostream>
+#include <vector>
 
 #include <boost/logic/tribool.hpp>
 
@@ -59,6 +60,16 @@ class IEntity {
   */
   virtual boost::logic::tribool canRow() const noexcept = 0;
 
+  /**
+    @return the row-ability of the entity for each residue of `CrossingIndex`
+      modulo the size of the result. Empty when the ability is constant or
+      when it isn't a periodic function of `CrossingIndex` alone
+  */
+  virtual const std::vector<bool>& canRowByCrossingIndex() const noexcept = 0;
+
+  /// @return the expression deciding if the entity is able to row
+  virtual std::string canRowExpr() const = 0;
+
   virtual std::string toString() const = 0;
 
  protected:
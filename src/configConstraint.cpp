@@ -31,8 +31,14 @@
 #include "util.h"
 #include "warnings.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
 #include <cmath>
 #include <iomanip>
+#include <mutex>
 #include <ranges>
 
 using namespace std;
@@ -184,6 +190,11 @@ bool ConfigConstraints::empty() const noexcept {
   return constraints.empty();
 }
 
+void ConfigConstraints::addMentionedIdsTo(unordered_set<unsigned>& ids) const {
+  for (const auto& c : constraints)
+    c->addMentionedIdsTo(ids);
+}
+
 bool ConfigConstraints::check(const ent::IsolatedEntities& ents) const {
   bool found{};
   for (const auto& c : constraints)
@@ -219,6 +230,72 @@ string ConfigConstraints::toString() const {
   return oss.str();
 }
 
+BanksConstraints::BanksConstraints(
+    grammar::ConstraintsVec&& constraints_,
+    const shared_ptr<const ent::AllEntities>& allEnts_,
+    bool allowed_ /* = true*/)
+    : ConfigConstraints{std::move(constraints_), *allEnts_, allowed_} {
+  const size_t entsCount{allEnts->count()};
+  if (!allEnts->masksAllowed() || entsCount > MaxTabulatedEntities)
+    return;
+
+  // The verdicts get computed only when needed
+  const size_t wordsCount{(size_t)(((1ULL << entsCount) + 63ULL) / 64ULL)};
+  checkedBanks = vector<atomic<uint64_t>>(wordsCount);
+  validBanks = vector<atomic<uint64_t>>(wordsCount);
+}
+
+bool BanksConstraints::check(const ent::IsolatedEntities& ents) const {
+  const optional<ent::IdsMask> mask{ents.idsMask()};
+  if (!mask)
+    return ConfigConstraints::check(ents);
+
+  bool verdict{};
+  if (!validBanks.empty()) {
+    const size_t word{size_t(*mask / 64ULL)};
+    const uint64_t bit{1ULL << (*mask % 64ULL)};
+    if (checkedBanks[word].load(memory_order_acquire) & bit) {
+      verdict = validBanks[word].load(memory_order_relaxed) & bit;
+
+    } else {
+      // Concurrent checks of the same bank compute the same verdict
+      verdict = verdictFor(ents);
+      if (verdict)
+        validBanks[word].fetch_or(bit, memory_order_relaxed);
+      checkedBanks[word].fetch_or(bit, memory_order_release);
+    }
+
+  } else {
+    bool cached{};
+    {
+      const shared_lock lock{cachedVerdictsMutex};
+      if (const auto it{cachedVerdicts.find(*mask)};
+          it != cend(cachedVerdicts)) {
+        verdict = it->second;
+        cached = true;
+      }
+    }
+    if (!cached) {
+      verdict = verdictFor(ents);
+      const unique_lock lock{cachedVerdictsMutex};
+      cachedVerdicts.emplace(*mask, verdict);
+    }
+  }
+
+#ifndef NDEBUG
+  if (!verdict)
+    cout << "violates " << *this << " : "
+         << ContView{ents.ids(), {"", " ", "\n"}};
+#endif  // NDEBUG
+  return verdict;
+}
+
+bool BanksConstraints::verdictFor(const ent::IsolatedEntities& ents) const {
+  const bool found{ranges::any_of(
+      constraints, [&ents](const auto& c) { return c->matches(ents); })};
+  return found == _allowed;
+}
+
 TransferConstraints::TransferConstraints(
     grammar::ConstraintsVec&& constraints_,
     const ent::AllEntities& allEnts_,
@@ -340,12 +417,33 @@ void TypesConstraint::validate(
                       to_string(capacity) + ")!"s};
 
   valExt.check(*this, allEnts);
+
+  maskProgram.reset();
+  if (!allEnts.masksAllowed())
+    return;
+
+  const size_t typesCount{allEnts.typesCount()};
+  MaskProgram program{.pool = &allEnts,
+                      .poolSize = allEnts.count(),
+                      .typesMasks = allEnts.typesMasks(),
+                      .minCounts = vector<unsigned>(typesCount),
+                      .maxCounts = vector<unsigned>(typesCount)};
+  for (const auto& [t, limits] : mandatoryTypes) {
+    const unsigned typeIdx{*allEnts.typeIndex(t)};
+    program.minCounts[typeIdx] = limits.first;
+    program.maxCounts[typeIdx] = limits.second;
+  }
+  for (const auto& [t, maxIncl] : optionalTypes)
+    program.maxCounts[*allEnts.typeIndex(t)] = maxIncl;
+  maskProgram = std::move(program);
 }
 
 TypesConstraint& TypesConstraint::addTypeRange(
     const string& newType,
     unsigned minIncl /* = 0U*/,
     unsigned maxIncl /* = UINT_MAX*/) {
+  maskProgram.reset();  // needs a new validation
+
   if (minIncl > maxIncl)
     throw logic_error{HERE.function_name() +
                       " - Parameter minIncl must be at most maxIncl!"s};
@@ -378,6 +476,20 @@ TypesConstraint& TypesConstraint::addTypeRange(
 
 bool TypesConstraint::matches(
     const ent::IsolatedEntities& ents) const noexcept {
+  if (const optional<ent::IdsMask> mask{ents.idsMask()};
+      mask && maskProgram && maskProgram->pool == &ents.pool() &&
+      maskProgram->poolSize == ents.pool().count()) {
+    const size_t typesCount{size(maskProgram->typesMasks)};
+    bool inRanges{true};
+    for (size_t typeIdx{}; typeIdx < typesCount; ++typeIdx) {
+      const unsigned count{
+          (unsigned)popcount(*mask & maskProgram->typesMasks[typeIdx])};
+      inRanges &= count >= maskProgram->minCounts[typeIdx] &&
+                  count <= maskProgram->maxCounts[typeIdx];
+    }
+    return inRanges;
+  }
+
   const map<string, set<unsigned>>& entsByTypes{ents.idsByTypes()};
 
   if (size(entsByTypes) > size(mandatoryTypes) + size(optionalTypes))
@@ -493,9 +605,35 @@ void IdsConstraint::validate(
                         "`!"s};
 
   valExt.check(*this, allEnts);
+
+  maskProgram.reset();
+  if (!allEnts.masksAllowed())
+    return;
+
+  const auto maskOf = [&allEnts](const unordered_set<unsigned>& group) {
+    ent::IdsMask mask{};
+    for (const unsigned id : group)
+      mask |= allEnts.maskOf(id);
+    return mask;
+  };
+  MaskProgram program{.pool = &allEnts,
+                      .poolSize = available,
+                      .avoided = maskOf(avoidedIds),
+                      .mentioned = maskOf(mentionedIds),
+                      .mandatory = {},
+                      .optional = {}};
+  program.mandatory.reserve(size(mandatoryGroups));
+  for (const auto& group : mandatoryGroups)
+    program.mandatory.push_back(maskOf(group));
+  program.optional.reserve(size(optionalGroups));
+  for (const auto& group : optionalGroups)
+    program.optional.push_back(maskOf(group));
+  maskProgram = std::move(program);
 }
 
 IdsConstraint& IdsConstraint::addMandatoryId(unsigned id) {
+  maskProgram.reset();  // needs a new validation
+
   if (!mentionedIds.insert(id).second)
     throw logic_error{HERE.function_name() + " - Duplicate id parameter: "s +
                       to_string(id)};
@@ -510,6 +648,8 @@ IdsConstraint& IdsConstraint::addMandatoryId(unsigned id) {
 }
 
 IdsConstraint& IdsConstraint::addOptionalId(unsigned id) {
+  maskProgram.reset();  // needs a new validation
+
   if (!mentionedIds.insert(id).second)
     throw logic_error{HERE.function_name() + " - Duplicate id parameter: "s +
                       to_string(id)};
@@ -524,6 +664,8 @@ IdsConstraint& IdsConstraint::addOptionalId(unsigned id) {
 }
 
 IdsConstraint& IdsConstraint::addAvoidedId(unsigned id) {
+  maskProgram.reset();  // needs a new validation
+
   if (!mentionedIds.insert(id).second)
     throw logic_error{HERE.function_name() + " - Duplicate id parameter: "s +
                       to_string(id)};
@@ -533,6 +675,8 @@ IdsConstraint& IdsConstraint::addAvoidedId(unsigned id) {
 }
 
 IdsConstraint& IdsConstraint::addUnspecifiedMandatory() noexcept {
+  maskProgram.reset();  // needs a new validation
+
   ++expectedExtraIds;
 
   if (_longestMatchLength != UINT_MAX)
@@ -542,6 +686,8 @@ IdsConstraint& IdsConstraint::addUnspecifiedMandatory() noexcept {
 }
 
 IdsConstraint& IdsConstraint::setUnbounded() noexcept {
+  maskProgram.reset();  // needs a new validation
+
   capacityLimit = false;
 
   _longestMatchLength = UINT_MAX;
@@ -550,6 +696,26 @@ IdsConstraint& IdsConstraint::setUnbounded() noexcept {
 }
 
 bool IdsConstraint::matches(const ent::IsolatedEntities& ents) const noexcept {
+  if (const optional<ent::IdsMask> mask{ents.idsMask()};
+      mask && maskProgram && maskProgram->pool == &ents.pool() &&
+      maskProgram->poolSize == ents.pool().count()) {
+    if (*mask & maskProgram->avoided)
+      return false;  // found unwanted entity id
+
+    for (const ent::IdsMask group : maskProgram->mandatory)
+      if (popcount(*mask & group) != 1)
+        return false;  // exactly 1 entity from a mandatory group must appear
+
+    for (const ent::IdsMask group : maskProgram->optional)
+      if (popcount(*mask & group) > 1)
+        return false;  // only 1 entity from a optional group can appear
+
+    const unsigned extraIds{
+        (unsigned)popcount(*mask & ~maskProgram->mentioned)};
+    return extraIds >= expectedExtraIds &&
+           (!capacityLimit || extraIds == expectedExtraIds);
+  }
+
   set<unsigned> ids{ents.ids()};
 
   for (const unsigned id : avoidedIds)
@@ -612,6 +778,10 @@ unsigned IdsConstraint::longestMismatchLength() const noexcept {
   return expectedExtraIds - 1U;
 }
 
+void IdsConstraint::addMentionedIdsTo(unordered_set<unsigned>& ids) const {
+  ids.insert(CBOUNDS(mentionedIds));
+}
+
 string IdsConstraint::toString() const {
   ostringstream oss;
   oss << "[";
@@ -659,6 +829,179 @@ string IdsConstraint::toString() const {
   return oss.str();
 }
 
+vector<bool> tabulateByCrossingIndex(const LogicalExpr& le) {
+  const optional<unsigned> period{le.crossingIndexPeriod()};
+  if (!period)
+    return {};
+
+  vector<bool> table(*period);
+  SymbolsTable st;
+  try {
+    for (unsigned crossingIdx{}; crossingIdx < *period; ++crossingIdx) {
+      st[SymbolsTable::CrossingIndexSlot] = (double)crossingIdx;
+      table[crossingIdx] = le.eval(st);
+    }
+  } catch (...) {
+    return {};
+  }
+  return table;
+}
+
+optional<ExprProgram> ExprProgram::compileContains(const IValues<double>& vs) {
+  ExprProgram program;
+  program.pushArg();
+  if (!vs.lowerContainsTo(program) || program.tooDeep)
+    return {};
+  return program;
+}
+
+bool ExprProgram::readsOnlyVariable(unsigned slot) const noexcept {
+  return ranges::all_of(code, [slot](const Instr& instr) {
+    return (instr.op != OpCode::Var || instr.operand == slot) &&
+           instr.op != OpCode::NamedVar;
+  });
+}
+
+void ExprProgram::append(Instr instr, int depthDelta) {
+  code.push_back(instr);
+  depth = size_t((ptrdiff_t)depth + depthDelta);
+  if (depth > MaxStackDepth)
+    tooDeep = true;
+}
+
+void ExprProgram::pushConst(double d) {
+  append({.op = OpCode::Const, .value = d}, 1);
+}
+
+void ExprProgram::pushVar(unsigned slot) {
+  append({.op = OpCode::Var, .operand = slot}, 1);
+}
+
+void ExprProgram::pushNamedVar(const string& name) {
+  const auto it{ranges::find(names, name)};
+  const unsigned nameIdx{(unsigned)distance(begin(names), it)};
+  if (it == cend(names))
+    names.push_back(name);
+  append({.op = OpCode::NamedVar, .operand = nameIdx}, 1);
+}
+
+void ExprProgram::pushArg() {
+  append({.op = OpCode::Arg}, 1);
+}
+
+void ExprProgram::add() {
+  append({.op = OpCode::Add}, -1);
+}
+
+void ExprProgram::modulus() {
+  append({.op = OpCode::Mod}, -1);
+}
+
+void ExprProgram::negate() {
+  append({.op = OpCode::Not}, 0);
+}
+
+void ExprProgram::setTop(double d) {
+  append({.op = OpCode::SetTop, .value = d}, 0);
+}
+
+size_t ExprProgram::jump() {
+  append({.op = OpCode::Jump}, 0);
+  return size(code) - 1ULL;
+}
+
+size_t ExprProgram::jumpIfEqual() {
+  append({.op = OpCode::JumpIfEqual}, -1);
+  return size(code) - 1ULL;
+}
+
+size_t ExprProgram::jumpIfInRange() {
+  append({.op = OpCode::JumpIfInRange}, -2);
+  return size(code) - 1ULL;
+}
+
+void ExprProgram::resolveJump(size_t instrIdx) noexcept {
+  code[instrIdx].operand = (unsigned)size(code);
+}
+
+double ExprProgram::run(const SymbolsTable& st, double arg /* = 0.*/) const {
+  array<double, MaxStackDepth> stack;
+  size_t top{};  // the count of values from the stack
+  const size_t codeSize{size(code)};
+  for (size_t pc{}; pc < codeSize; ++pc) {
+    const Instr& instr{code[pc]};
+    switch (instr.op) {
+      using enum OpCode;
+
+      case Const:
+        stack[top++] = instr.value;
+        break;
+
+      case Var:
+        stack[top++] = st.at(instr.operand);
+        break;
+
+      case NamedVar:
+        stack[top++] = st.at(names[instr.operand]);
+        break;
+
+      case Arg:
+        stack[top++] = arg;
+        break;
+
+      case Add:
+        --top;
+        stack[top - 1ULL] += stack[top];
+        break;
+
+      case Mod: {
+        --top;
+        const long numeratorL{Modulus::validLong(stack[top - 1ULL])},
+            denominatorL{Modulus::validLong(stack[top])};
+        stack[top - 1ULL] =
+            (double)Modulus::validOperation(numeratorL, denominatorL);
+        break;
+      }
+
+      case Not:
+        stack[top - 1ULL] = (stack[top - 1ULL] != 0.) ? 0. : 1.;
+        break;
+
+      case SetTop:
+        stack[top - 1ULL] = instr.value;
+        break;
+
+      case Jump:
+        pc = instr.operand - 1ULL;
+        break;
+
+      case JumpIfEqual: {
+        const double v{stack[--top]};
+        ValueOrRange::validateDouble(v);
+        if (abs(stack[top - 1ULL] - v) < Eps)
+          pc = instr.operand - 1ULL;
+        break;
+      }
+
+      case JumpIfInRange: {
+        top -= 2ULL;
+        const double from{stack[top]}, to{stack[top + 1ULL]};
+        ValueOrRange::validateDouble(from);
+        ValueOrRange::validateDouble(to);
+        ValueOrRange::validateRange(from, to);
+        if (from <= stack[top - 1ULL] && to >= stack[top - 1ULL])
+          pc = instr.operand - 1ULL;
+        break;
+      }
+
+      default:
+        throw logic_error{HERE.function_name() + " - Unknown operation!"s};
+    }
+  }
+  assert(top == 1ULL);
+  return stack.front();
+}
+
 BoolConst::BoolConst(bool b) noexcept : LogicalExpr{} {
   val = b;
 }
@@ -667,6 +1010,11 @@ bool BoolConst::eval(const SymbolsTable&) const noexcept {
   return *val;
 }
 
+bool BoolConst::lowerTo(ExprProgram& program) const {
+  program.pushConst(*val ? 1. : 0.);
+  return true;
+}
+
 string BoolConst::toString() const {
   ostringstream oss;
   oss << boolalpha << *val;
@@ -688,6 +1036,23 @@ bool Not::eval(const SymbolsTable& st) const {
   return !_le->eval(st);
 }
 
+bool Not::lowerTo(ExprProgram& program) const {
+  if (val) {
+    program.pushConst(*val ? 1. : 0.);
+    return true;
+  }
+  if (!_le->lowerTo(program))
+    return false;
+  program.negate();
+  return true;
+}
+
+optional<unsigned> Not::crossingIndexPeriod() const noexcept {
+  if (val)
+    return 1U;
+  return _le->crossingIndexPeriod();
+}
+
 string Not::toString() const {
   ostringstream oss;
   oss << "not(" << _le->toString() << ')';
@@ -798,6 +1163,29 @@ pair<double, double> ValueOrRange::range(const SymbolsTable& st) const {
   return {from, to};
 }
 
+optional<size_t> ValueOrRange::lowerCoverageTestTo(
+    ExprProgram& program) const {
+  if (const ValueType * value_{get_if<ValueType>(&_valueOrRange)}) {
+    if (!(*value_)->lowerTo(program))
+      return {};
+    return program.jumpIfEqual();
+  }
+
+  const RangeType& range{get<RangeType>(_valueOrRange)};
+  if (!range.first->lowerTo(program) || !range.second->lowerTo(program))
+    return {};
+  return program.jumpIfInRange();
+}
+
+optional<unsigned> ValueOrRange::crossingIndexPeriod() const noexcept {
+  if (const ValueType * value_{get_if<ValueType>(&_valueOrRange)})
+    return (*value_)->crossingIndexPeriod();
+
+  const RangeType& range{get<RangeType>(_valueOrRange)};
+  return commonPeriod(range.first->crossingIndexPeriod(),
+                      range.second->crossingIndexPeriod());
+}
+
 string ValueOrRange::toString() const {
   ostringstream oss;
   if (const ValueType * value_{get_if<ValueType>(&_valueOrRange)})
@@ -850,6 +1238,34 @@ bool ValueSet::contains(const double& v,
   return false;
 }
 
+bool ValueSet::lowerContainsTo(ExprProgram& program) const {
+  // Each covering value / range jumps to the `found` branch
+  vector<size_t> jumpsWhenFound;
+  for (const ValueOrRange& vor : vors) {
+    const optional<size_t> jumpWhenFound{vor.lowerCoverageTestTo(program)};
+    if (!jumpWhenFound)
+      return false;
+    jumpsWhenFound.push_back(*jumpWhenFound);
+  }
+
+  program.setTop(0.);  // not found
+  const size_t jumpToEnd{program.jump()};
+
+  for (const size_t jumpWhenFound : jumpsWhenFound)
+    program.resolveJump(jumpWhenFound);
+  program.setTop(1.);  // found
+
+  program.resolveJump(jumpToEnd);
+  return true;
+}
+
+optional<unsigned> ValueSet::crossingIndexPeriod() const noexcept {
+  optional<unsigned> period{1U};
+  for (const ValueOrRange& vor : vors)
+    period = commonPeriod(period, vor.crossingIndexPeriod());
+  return period;
+}
+
 string ValueSet::toString() const {
   return ContView{vors, {"{", ", ", "}"}}.toString();
 }
@@ -862,21 +1278,47 @@ double NumericConst::eval(const SymbolsTable&) const noexcept {
   return *val;
 }
 
+bool NumericConst::lowerTo(ExprProgram& program) const {
+  program.pushConst(*val);
+  return true;
+}
+
 string NumericConst::toString() const {
   ostringstream oss;
   oss << *val;
+
+  // The default precision might drop some digits, while the text of an
+  // expression must identify it (see ScenarioDetails::canonicalForm())
+  if (stod(oss.str()) != *val) {
+    oss.str({});
+    oss << setprecision(numeric_limits<double>::max_digits10) << *val;
+  }
   return oss.str();
 }
 
-NumericVariable::NumericVariable(const string& varName) noexcept
-    : NumericExpr{}, name(varName) {}
+NumericVariable::NumericVariable(const string& varName)
+    : NumericExpr{}, name(varName), slot{SymbolsTable::slotOf(varName)} {}
 
 bool NumericVariable::dependsOnVariable(const string& varName) const noexcept {
   return name == varName;
 }
 
 double NumericVariable::eval(const SymbolsTable& st) const {
-  return st.at(name);
+  return slot ? st.at(*slot) : st.at(name);
+}
+
+bool NumericVariable::lowerTo(ExprProgram& program) const {
+  if (slot)
+    program.pushVar(*slot);
+  else
+    program.pushNamedVar(name);
+  return true;
+}
+
+optional<double> NumericVariable::crossingIndexOffset() const noexcept {
+  if (slot == SymbolsTable::CrossingIndexSlot)
+    return 0.;
+  return {};
 }
 
 string NumericVariable::toString() const noexcept {
@@ -903,6 +1345,36 @@ double Addition::eval(const SymbolsTable& st) const {
   return left->eval(st) + right->eval(st);
 }
 
+bool Addition::lowerTo(ExprProgram& program) const {
+  if (val) {
+    program.pushConst(*val);
+    return true;
+  }
+  if (!left->lowerTo(program) || !right->lowerTo(program))
+    return false;
+  program.add();
+  return true;
+}
+
+optional<unsigned> Addition::crossingIndexPeriod() const noexcept {
+  if (val)
+    return 1U;
+  return commonPeriod(left->crossingIndexPeriod(),
+                      right->crossingIndexPeriod());
+}
+
+optional<double> Addition::crossingIndexOffset() const noexcept {
+  if (val)
+    return {};
+  if (const optional<double> offset{left->crossingIndexOffset()};
+      offset && right->constValue())
+    return *offset + *right->constValue();
+  if (const optional<double> offset{right->crossingIndexOffset()};
+      offset && left->constValue())
+    return *offset + *left->constValue();
+  return {};
+}
+
 string Addition::toString() const {
   if (val)
     return to_string(*val);
@@ -965,6 +1437,34 @@ double Modulus::eval(const SymbolsTable& st) const {
   return (double)validOperation(numeratorL, denominatorL);
 }
 
+bool Modulus::lowerTo(ExprProgram& program) const {
+  if (val) {
+    program.pushConst(*val);
+    return true;
+  }
+  if (!numerator->lowerTo(program) || !denominator->lowerTo(program))
+    return false;
+  program.modulus();
+  return true;
+}
+
+optional<unsigned> Modulus::crossingIndexPeriod() const noexcept {
+  if (val)
+    return 1U;
+
+  const optional<double>& k{denominator->constValue()};
+  if (const optional<double> c{numerator->crossingIndexOffset()}; c && k) {
+    const double absK{abs(*k)};
+    if (absK < .5 || absK > MaxCrossingIndexPeriod || *c < -Eps ||
+        abs(*c - round(*c)) > Eps || abs(absK - round(absK)) > Eps)
+      return {};
+    return (unsigned)lround(absK);
+  }
+
+  return commonPeriod(numerator->crossingIndexPeriod(),
+                      denominator->crossingIndexPeriod());
+}
+
 string Modulus::toString() const {
   if (val)
     return to_string(*val);
@@ -14,11 +14,19 @@
 #define H_CONFIG_CONSTRAINT
 
 #include "configParser.h"
+#include "entitiesManager.h"
 #include "util.h"
 
+#include <atomic>
+#include <cstdint>
 #include <iterator>
+#include <optional>
+#include <shared_mutex>
+#include <type_traits>
+#include <unordered_map>
 #include <unordered_set>
 #include <variant>
+#include <vector>
 
 #include <gsl/pointers>
 
@@ -102,6 +110,9 @@ class ConfigConstraints {
 
   [[nodiscard]] bool empty() const noexcept;  ///< are there any constraints?
 
+  /// Adds to `ids` the ids of the entities mentioned individually
+  void addMentionedIdsTo(std::unordered_set<unsigned>& ids) const;
+
   /**
     For _allowed == true - are these entities
       matching at least 1 of the allowed configurations?
@@ -131,6 +142,66 @@ class ConfigConstraints {
   bool _allowed;
 };
 
+/**
+  ConfigConstraints for the banks, which memoize their verdicts by the ids mask
+  of the checked bank.
+
+  Bank constraints don't depend on any context, so each bank configuration
+  is either always valid or always invalid.
+  For up to MaxTabulatedEntities entities, the verdicts are kept in bit tables
+  indexed by the bank masks. Each verdict gets computed when its bank is first
+  checked, so a search visiting few states doesn't pay for all of them.
+  For more entities that still allow masks, the verdicts are cached in a map.
+*/
+class BanksConstraints : public ConfigConstraints {
+ public:
+  /// Largest count of entities whose bank verdicts are kept in bit tables
+  /// (2 tables of 2^MaxTabulatedEntities bits)
+  static constexpr size_t MaxTabulatedEntities{16ULL};
+
+  /// The constraints should be either all enforced, or none of them is allowed
+  /// @throw logic_error if any constraint is invalid
+  BanksConstraints(grammar::ConstraintsVec&& constraints_,
+                   const std::shared_ptr<const ent::AllEntities>& allEnts_,
+                   bool allowed_ = true);
+  ~BanksConstraints() noexcept override = default;
+
+  BanksConstraints(const BanksConstraints&) = delete;
+  BanksConstraints(BanksConstraints&&) = delete;
+  void operator=(const BanksConstraints&) = delete;
+  void operator=(BanksConstraints&&) = delete;
+
+  /**
+    Same as ConfigConstraints::check, but looks up or caches the verdict
+    when `ents` are expressed as a mask
+
+    @param ents the entities to be checked against these ConfigConstraints
+
+    @return as explained for ConfigConstraints::check
+  */
+  [[nodiscard]] bool check(const ent::IsolatedEntities& ents) const override;
+
+  PROTECTED :
+
+      /// @return the verdict for `ents`, without any reporting
+      [[nodiscard]] bool
+      verdictFor(const ent::IsolatedEntities& ents) const;
+
+  /// Bit `mask` is set when the bank with the ids from `mask` was checked.
+  /// Empty when there are too many entities to tabulate them
+  mutable std::vector<std::atomic<std::uint64_t>> checkedBanks;
+
+  /// Bit `mask` is set when the bank with the ids from `mask` was checked and
+  /// is valid. Empty when there are too many entities to tabulate them
+  mutable std::vector<std::atomic<std::uint64_t>> validBanks;
+
+  /// Verdicts of the banks checked so far, when they are not tabulated
+  mutable std::unordered_map<ent::IdsMask, bool> cachedVerdicts;
+
+  /// Guards cachedVerdicts
+  mutable std::shared_mutex cachedVerdictsMutex;
+};
+
 /// Allows performing canRow, allowedLoads and other checks on raft/bridge
 /// configurations
 class IContextValidator {
@@ -501,6 +572,29 @@ class TypesConstraint : public IConfigConstraint {
   std::unordered_map<std::string, unsigned> optionalTypes;
 
   unsigned _longestMatchLength{};  ///< length of the longest possible match
+
+  /**
+  Compiled form of the constraint for the entities expressed as masks.
+  The interned types of the pool index all its vectors
+  */
+  struct MaskProgram {
+    /// The pool of entities providing the interned types and the masks
+    const ent::AllEntities* pool{};
+
+    size_t poolSize{};  ///< the size of the pool when compiling the program
+
+    std::vector<ent::IdsMask> typesMasks;  ///< entities of each type
+
+    /// Min and max inclusive count of each type. Unwanted types allow 0 .. 0
+    std::vector<unsigned> minCounts, maxCounts;
+  };
+
+  /**
+  The program compiled by `validate` for the entities it received.
+  Empty when these entities don't allow masks or the constraint changed after
+  the validation
+  */
+  mutable std::optional<MaskProgram> maskProgram;
 };
 
 /// The provided constraint uses entity ids
@@ -530,6 +624,7 @@ class IdsConstraint : public IConfigConstraint {
           HERE.function_name() +
           " - Found id(s) mentioned earlier in the same Ids constraint!"s};
     mentionedIds = newMentionedIds;
+    maskProgram.reset();  // needs a new validation
 
     mandatoryGroups.emplace_back(CBOUNDS(group));
 
@@ -554,6 +649,7 @@ class IdsConstraint : public IConfigConstraint {
           HERE.function_name() +
           " - Found id(s) mentioned earlier in the same Ids constraint!"s};
     mentionedIds = newMentionedIds;
+    maskProgram.reset();  // needs a new validation
 
     optionalGroups.emplace_back(CBOUNDS(group));
 
@@ -597,6 +693,9 @@ class IdsConstraint : public IConfigConstraint {
   /// @return the length of the longest possible mismatch
   [[nodiscard]] unsigned longestMismatchLength() const noexcept override;
 
+  /// Adds to `ids` the ids of the entities mentioned individually
+  void addMentionedIdsTo(std::unordered_set<unsigned>& ids) const override;
+
   [[nodiscard]] std::string toString() const override;
 
   PROTECTED :
@@ -630,8 +729,155 @@ class IdsConstraint : public IConfigConstraint {
     + expectedExtraIds + size of optional.
   */
   bool capacityLimit{true};
+
+  /**
+  Compiled form of the constraint for the entities expressed as masks.
+  Matching it needs only a few bit operations and no allocations
+  */
+  struct MaskProgram {
+    /// The pool of entities providing the bits of the masks
+    const ent::AllEntities* pool{};
+
+    size_t poolSize{};  ///< the size of the pool when compiling the program
+
+    ent::IdsMask avoided{};    ///< the ids to avoid
+    ent::IdsMask mentioned{};  ///< all the ids mentioned by the constraint
+
+    /// Exactly 1 id from each of these masks must appear
+    std::vector<ent::IdsMask> mandatory;
+
+    /// At most 1 id from each of these masks might appear
+    std::vector<ent::IdsMask> optional;
+  };
+
+  /**
+  The program compiled by `validate` for the entities it received.
+  Empty when these entities don't allow masks or the constraint changed after
+  the validation
+  */
+  mutable std::optional<MaskProgram> maskProgram;
 };
 
+/**
+  Flat form of a logical / numeric expression or of the membership test
+  within a set of values, as a compact bytecode.
+
+  Runs as a stack machine on the slots of a Symbols Table,
+  so it involves no string hashing and no virtual calls through the tree
+  of the expression. Only the variables without a fixed slot are looked up
+  by their name.
+*/
+class ExprProgram {
+ public:
+  /// Max depth of the stack of the machine. Deeper expressions don't compile
+  static constexpr size_t MaxStackDepth{16ULL};
+
+  /// @return the program computing `e` or nothing if `e` can't be lowered
+  template <typename Type>
+  [[nodiscard]] static std::optional<ExprProgram> compile(
+      const AbsExpr<Type>& e) {
+    ExprProgram program;
+    if (!e.lowerTo(program) || program.tooDeep)
+      return {};
+    return program;
+  }
+
+  /**
+    @return the program checking if `vs` contains the argument of `run`
+    or nothing if `vs` can't be lowered
+  */
+  [[nodiscard]] static std::optional<ExprProgram> compileContains(
+      const IValues<double>& vs);
+
+  ExprProgram(const ExprProgram&) = default;
+  ExprProgram(ExprProgram&&) noexcept = default;
+  ~ExprProgram() noexcept = default;
+
+  ExprProgram& operator=(const ExprProgram&) = default;
+  ExprProgram& operator=(ExprProgram&&) noexcept = default;
+
+  /**
+    @param st the symbols table providing the values of the variables
+    @param arg the value to check for a program from `compileContains`
+    @return the value of the expression (0 / 1 for logical expressions)
+    @throw the same exceptions as the evaluation of the lowered expression
+  */
+  [[nodiscard]] double run(const SymbolsTable& st, double arg = 0.) const;
+
+  /// @return true if the program reads no other variable than the one from
+  /// `slot`
+  [[nodiscard]] bool readsOnlyVariable(unsigned slot) const noexcept;
+
+  // Builder methods for `lowerTo` and `lowerContainsTo`.
+  // The jump methods return the index of the instruction to be resolved.
+
+  void pushConst(double d);            ///< pushes `d`
+  void pushVar(unsigned slot);         ///< pushes the variable from `slot`
+  void pushNamedVar(const std::string& name);  ///< pushes the variable `name`
+  void pushArg();                      ///< pushes the argument of `run`
+  void add();                          ///< replaces 2 terms by their sum
+  void modulus();                      ///< replaces 2 terms by their modulus
+  void negate();                       ///< logical negation of the top
+  void setTop(double d);               ///< replaces the top with `d`
+  [[nodiscard]] size_t jump();         ///< unconditional jump
+
+  /// Pops a value and jumps if it equals the new top
+  [[nodiscard]] size_t jumpIfEqual();
+
+  /// Pops the limits of a range and jumps if they contain the new top
+  [[nodiscard]] size_t jumpIfInRange();
+
+  /// Lets the jump from instruction `instrIdx` target the next instruction
+  void resolveJump(size_t instrIdx) noexcept;
+
+  PROTECTED :
+
+      ExprProgram() noexcept = default;
+
+  /// Operations of the machine
+  enum class OpCode : unsigned char {
+    Const,        ///< push `value`
+    Var,          ///< push the variable from slot `operand`
+    NamedVar,     ///< push the variable `names[operand]`
+    Arg,          ///< push the argument of `run`
+    Add,          ///< replace 2 terms by their sum
+    Mod,          ///< replace 2 terms by their modulus
+    Not,          ///< logical negation of the top
+    SetTop,       ///< replace the top with `value`
+    Jump,         ///< jump to `operand`
+    JumpIfEqual,  ///< pop a value; jump to `operand` if it equals the top
+    JumpIfInRange  ///< pop a range; jump to `operand` if it covers the top
+  };
+
+  /// An instruction of the machine
+  struct Instr {
+    OpCode op;
+    /// slot of a variable, index within `names` or target of a jump
+    unsigned operand{};
+    double value{};      ///< constant of the operation
+  };
+
+  /// Appends an instruction changing the depth of the stack by `depthDelta`
+  void append(Instr instr, int depthDelta);
+
+  std::vector<Instr> code;  ///< the instructions
+
+  /// The names of the variables without fixed slots
+  std::vector<std::string> names;
+
+  size_t depth{};     ///< the depth of the stack after the last instruction
+  bool tooDeep{};     ///< set when the stack would exceed MaxStackDepth
+};
+
+/**
+  Tabulates a logical expression depending only on `CrossingIndex` through
+  a period of at most MaxCrossingIndexPeriod.
+  @return the values of `le` for each residue of CrossingIndex modulo
+  the size of the result or an empty table when `le` is not such an expression
+  or when its evaluation fails for some residue
+*/
+[[nodiscard]] std::vector<bool> tabulateByCrossingIndex(const LogicalExpr& le);
+
 /// bool constants: true or false
 class BoolConst : public LogicalExpr {
  public:
@@ -646,6 +892,8 @@ class BoolConst : public LogicalExpr {
   /// @return the contained bool constant
   [[nodiscard]] bool eval(const SymbolsTable&) const noexcept override;
 
+  bool lowerTo(ExprProgram& program) const override;
+
   [[nodiscard]] std::string toString() const override;
 };
 
@@ -666,6 +914,11 @@ class Not : public LogicalExpr {
 
   [[nodiscard]] bool eval(const SymbolsTable& st) const override;
 
+  bool lowerTo(ExprProgram& program) const override;
+
+  [[nodiscard]] std::optional<unsigned> crossingIndexPeriod()
+      const noexcept override;
+
   [[nodiscard]] std::string toString() const override;
 
   PROTECTED :
@@ -722,9 +975,23 @@ class ValueOrRange {
   */
   [[nodiscard]] std::pair<double, double> range(const SymbolsTable& st) const;
 
+  /**
+    Appends to `program` the instructions jumping when this value / range
+    covers the top of its stack
+    @return the index of the jump instruction or nothing when some expression
+    can't be lowered
+  */
+  [[nodiscard]] std::optional<size_t> lowerCoverageTestTo(
+      ExprProgram& program) const;
+
+  /// @return the common period of the involved expressions (see AbsExpr)
+  [[nodiscard]] std::optional<unsigned> crossingIndexPeriod() const noexcept;
+
   [[nodiscard]] std::string toString() const;
 
  private:
+  friend class ExprProgram;  // validates the values computed by the program
+
   /// @throw logic_error for NaN values
   static void validateDouble(double d);
 
@@ -768,6 +1035,11 @@ class ValueSet : public IValues<double> {
   [[nodiscard]] bool contains(const double& v,
                               const SymbolsTable& st = {}) const override;
 
+  bool lowerContainsTo(ExprProgram& program) const override;
+
+  [[nodiscard]] std::optional<unsigned> crossingIndexPeriod()
+      const noexcept override;
+
   [[nodiscard]] std::string toString() const override;
 
   PROTECTED :
@@ -811,6 +1083,26 @@ class BelongToCondition : public LogicalExpr {
     return _valueSet->contains(_e->eval(st), st);
   }
 
+  bool lowerTo(ExprProgram& program) const override {
+    if (val) {
+      program.pushConst(*val ? 1. : 0.);
+      return true;
+    }
+
+    if constexpr (std::is_same_v<Type, double>)
+      return _e->lowerTo(program) && _valueSet->lowerContainsTo(program);
+    else
+      return false;
+  }
+
+  [[nodiscard]] std::optional<unsigned> crossingIndexPeriod()
+      const noexcept override {
+    if (val)
+      return 1U;
+    return commonPeriod(_e->crossingIndexPeriod(),
+                        _valueSet->crossingIndexPeriod());
+  }
+
   [[nodiscard]] std::string toString() const override {
     std::ostringstream oss;
     oss << *_e << " in " << *_valueSet;
@@ -841,13 +1133,16 @@ class NumericConst : public NumericExpr {
   /// @return the contained constant
   [[nodiscard]] double eval(const SymbolsTable&) const noexcept override;
 
+  bool lowerTo(ExprProgram& program) const override;
+
   [[nodiscard]] std::string toString() const override;
 };
 
 /// The name of a variable
 class NumericVariable : public NumericExpr {
  public:
-  explicit NumericVariable(const std::string& varName) noexcept;
+  /// Resolves also the fixed slot of the variable, if it has one
+  explicit NumericVariable(const std::string& varName);
   ~NumericVariable() noexcept override = default;
 
   NumericVariable(const NumericVariable&) = delete;
@@ -862,12 +1157,22 @@ class NumericVariable : public NumericExpr {
   /// @throw out_of_range when name is missing from the symbols table
   [[nodiscard]] double eval(const SymbolsTable& st) const override;
 
+  /// Lowers only the variables with fixed slots
+  bool lowerTo(ExprProgram& program) const override;
+
+  /// @return 0 for `CrossingIndex`; otherwise nothing
+  [[nodiscard]] std::optional<double> crossingIndexOffset()
+      const noexcept override;
+
   [[nodiscard]] std::string toString() const noexcept override;
 
   PROTECTED :
 
       /// The considered name
       std::string name;
+
+  /// The fixed slot of the variable within the Symbols Tables, if any
+  std::optional<unsigned> slot;
 };
 
 /// Adding 2 numeric expressions
@@ -889,6 +1194,15 @@ class Addition : public NumericExpr {
   /// @throw out_of_range whenever a variable isn't found
   [[nodiscard]] double eval(const SymbolsTable& st) const override;
 
+  bool lowerTo(ExprProgram& program) const override;
+
+  [[nodiscard]] std::optional<unsigned> crossingIndexPeriod()
+      const noexcept override;
+
+  /// @return c for `CrossingIndex + c` shapes, where c is constant
+  [[nodiscard]] std::optional<double> crossingIndexOffset()
+      const noexcept override;
+
   [[nodiscard]] std::string toString() const override;
 
   PROTECTED :
@@ -925,9 +1239,21 @@ class Modulus : public NumericExpr {
   */
   [[nodiscard]] double eval(const SymbolsTable& st) const override;
 
+  bool lowerTo(ExprProgram& program) const override;
+
+  /**
+    `(CrossingIndex + c) mod k` has period |k| for constant integers c >= 0
+    and k != 0, as the non-negative CrossingIndex keeps the numerator
+    non-negative
+  */
+  [[nodiscard]] std::optional<unsigned> crossingIndexPeriod()
+      const noexcept override;
+
   [[nodiscard]] std::string toString() const override;
 
  protected:
+  friend class ExprProgram;  // validates the operands computed by the program
+
   /**
   @throw logic_error for non-integer values
   @return the corresponding integer value
@@ -21,12 +21,50 @@
 #include <cassert>
 #include <iomanip>
 #include <memory>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
 
 #include <gsl/pointers>
 
 using namespace std;
 
-namespace rc::sol {
+namespace rc {
+
+namespace ent {
+
+CrossingDurationExt::CrossingDurationExt(
+    const shared_ptr<const AllEntities>& all_,
+    optional<unsigned> duration_ /* = {}*/,
+    unique_ptr<IMovingEntitiesExt> nextExt_
+    /* = make_unique<DefMovingEntitiesExt>()*/) noexcept
+    : AbsMovingEntitiesExt{all_, std::move(nextExt_)}, duration{duration_} {}
+
+void CrossingDurationExt::_newGroup(const set<unsigned>&) noexcept {
+  if (exchange(groupSelected, true))
+    duration.reset();
+}
+
+void CrossingDurationExt::_addEntity(unsigned) noexcept {
+  duration.reset();
+}
+
+void CrossingDurationExt::_removeEntity(unsigned) noexcept {
+  duration.reset();
+}
+
+unique_ptr<IMovingEntitiesExt> CrossingDurationExt::_clone(
+    unique_ptr<IMovingEntitiesExt> cloneOfNextExt) const noexcept {
+  auto result{make_unique<CrossingDurationExt>(all, duration,
+                                               std::move(cloneOfNextExt))};
+  result->groupSelected = groupSelected;
+  return result;
+}
+
+}  // namespace ent
+
+namespace sol {
 
 unique_ptr<const IStateExt> TimeStateExt::_clone(
     const shared_ptr<const IStateExt>& nextExt_) const noexcept {
@@ -56,6 +94,14 @@ bool TimeStateExt::_isNotBetterThan(const IState& s2) const {
 shared_ptr<const IStateExt> TimeStateExt::_extensionForNextState(
     const ent::MovingEntities& movedEnts,
     const shared_ptr<const IStateExt>& fromNextExt) const {
+  // Most moved groups know already their duration
+  if (const ent::CrossingDurationExt* const durationExt{
+          ent::AbsMovingEntitiesExt::selectExt<ent::CrossingDurationExt>(
+              movedEnts.getExtension())};
+      durationExt && durationExt->crossingDuration())
+    return make_shared<const TimeStateExt>(
+        _time + *durationExt->crossingDuration(), *info, fromNextExt);
+
   unsigned timeOfNextState{_time};
   bool foundMatch{};
   for (const cond::ConfigurationsTransferDuration& ctdItem : info->ctdItems) {
@@ -105,4 +151,5 @@ unsigned TimeStateExt::time() const noexcept {
   return _time;
 }
 
-}  // namespace rc::sol
+}  // namespace sol
+}  // namespace rc
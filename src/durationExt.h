@@ -25,7 +25,68 @@
 
 #include "scenarioDetails.h"
 
-namespace rc::sol {
+#include <optional>
+
+namespace rc {
+
+namespace ent {
+
+/**
+Extension caching the crossing duration of the entities from the raft/bridge,
+when the scenario provides CrossingDurationsOfConfigurations items.
+The duration is resolved by ScenarioDetails::crossingDurationOf once for
+each configuration generated by the solver and provided to the constructor
+*/
+class CrossingDurationExt : public AbsMovingEntitiesExt {
+ public:
+  /// `duration_` concerns the group selected first (the one from the
+  /// constructor of the moving entities) or the copies of that group
+  explicit CrossingDurationExt(
+      const std::shared_ptr<const AllEntities>& all_,
+      std::optional<unsigned> duration_ = {},
+      std::unique_ptr<IMovingEntitiesExt> nextExt_ =
+          std::make_unique<DefMovingEntitiesExt>()) noexcept;
+  ~CrossingDurationExt() noexcept override = default;
+
+  CrossingDurationExt(const CrossingDurationExt&) = delete;
+  CrossingDurationExt(CrossingDurationExt&&) = delete;
+  void operator=(const CrossingDurationExt&) = delete;
+  void operator=(CrossingDurationExt&&) = delete;
+
+  /**
+  @return the crossing duration of the group or nothing when it wasn't
+  provided or when the group was changed since
+  */
+  [[nodiscard]] const std::optional<unsigned>& crossingDuration()
+      const noexcept {
+    return duration;
+  }
+
+  PROTECTED :
+
+      /// Selecting a new group of entities for moving to the other bank.
+      /// Forgets duration, unless this is the first selected group
+      void
+      _newGroup(const std::set<unsigned>& ids) noexcept override;
+
+  /// Adds a new entity to the group from the raft/bridge. Forgets duration
+  void _addEntity(unsigned id) noexcept override;
+
+  /// Removes an existing entity from the raft/bridge. Forgets duration
+  void _removeEntity(unsigned id) noexcept override;
+
+  /// @return a clone of these extensions
+  [[nodiscard]] std::unique_ptr<IMovingEntitiesExt> _clone(
+      std::unique_ptr<IMovingEntitiesExt> cloneOfNextExt)
+      const noexcept override;
+
+  std::optional<unsigned> duration;  ///< the duration of the group, if known
+  bool groupSelected{};  ///< false until the first group gets selected
+};
+
+}  // namespace ent
+
+namespace sol {
 
 /// Allows State to contain a time entry - the moment the state is reached
 class TimeStateExt : public AbsStateExt {
@@ -76,6 +137,7 @@ class TimeStateExt : public AbsStateExt {
   unsigned _time;  ///< the moment this state is reached
 };
 
-}  // namespace rc::sol
+}  // namespace sol
+}  // namespace rc
 
 #endif  // H_DURATION_EXT not defined
@@ -29,6 +29,7 @@
 #include "entity.h"
 #include "util.h"
 
+#include <bit>
 #include <cassert>
 #include <iterator>
 #include <ranges>
@@ -115,7 +116,16 @@ AllEntities& AllEntities::operator+=(const shared_ptr<const IEntity>& e) {
                        name + "`"s};
 
   byId[id] = byName[name] = e;
+  const unsigned bit{(unsigned)size(entities)};
+  bitById[id] = bit;
   _idsByTypes[type].insert(id);
+  const auto [itTypeIdx, newType] =
+      typeIndices.try_emplace(type, (unsigned)size(typeIndices));
+  if (bit < MaxMaskedEntities) {
+    if (newType)
+      _typesMasks.push_back({});
+    _typesMasks[itTypeIdx->second] |= IdsMask{1ULL} << bit;
+  }
   _idsByWeight[ent.weight()].insert(id);
   if (!ent.startsFromRightBank())
     _idsStartingFromLeftBank.push_back(id);
@@ -161,6 +171,46 @@ const vector<unsigned>& AllEntities::idsStartingFromRightBank() const noexcept {
   return _idsStartingFromRightBank;
 }
 
+bool AllEntities::masksAllowed() const noexcept {
+  return size(entities) <= MaxMaskedEntities;
+}
+
+IdsMask AllEntities::maskOf(unsigned id) const {
+  const unsigned bit{bitById.at(id)};
+  if (bit >= MaxMaskedEntities)
+    throw logic_error{HERE.function_name() +
+                      " - Too many entities for using masks!"s};
+  return IdsMask{1ULL} << bit;
+}
+
+unsigned AllEntities::idOfBit(unsigned bit) const noexcept {
+  return entities[bit]->id();
+}
+
+IdsMask AllEntities::fullMask() const noexcept {
+  const size_t entsCount{size(entities)};
+  if (entsCount >= MaxMaskedEntities)
+    return ~IdsMask{};
+  return (IdsMask{1ULL} << entsCount) - 1ULL;
+}
+
+size_t AllEntities::typesCount() const noexcept {
+  return size(typeIndices);
+}
+
+optional<unsigned> AllEntities::typeIndex(const string& type) const noexcept {
+  if (const auto it{typeIndices.find(type)}; it != cend(typeIndices))
+    return it->second;
+  return {};
+}
+
+const vector<IdsMask>& AllEntities::typesMasks() const {
+  if (!masksAllowed())
+    throw logic_error{HERE.function_name() +
+                      " - Too many entities for using masks!"s};
+  return _typesMasks;
+}
+
 string AllEntities::toString() const {
   return ContView{entities,
                   {"Entities: [ ", ", ", " ]"},
@@ -168,13 +218,35 @@ string AllEntities::toString() const {
       .toString();
 }
 
+IsolatedEntities::IsolatedEntities(const shared_ptr<const AllEntities>& all_,
+                                   IdsMask mask_) noexcept
+    : all{all_},
+      masked{true},
+      _mask{mask_},
+      cachesState{mask_ ? CachesState::Stale : CachesState::Synced} {
+  Expects(all->masksAllowed());
+}
+
 IsolatedEntities::IsolatedEntities(const IsolatedEntities& other) noexcept
-    : all{other.all}, _ids{other._ids}, byType{other.byType} {}
+    : all{other.all}, masked{other.masked}, _mask{other._mask} {
+  // The caches of a masked subset are rebuilt only on demand
+  if (!masked) {
+    _ids = other._ids;
+    byType = other.byType;
+  } else
+    cachesState = _mask ? CachesState::Stale : CachesState::Synced;
+}
 
 IsolatedEntities::IsolatedEntities(IsolatedEntities&& other) noexcept
     : all{other.all},
+      masked{other.masked},
+      _mask{other._mask},
+      cachesState{other.cachesState.load()},
       _ids{std::move(other._ids)},
-      byType{std::move(other.byType)} {}
+      byType{std::move(other.byType)} {
+  if (masked)
+    other.cachesState = CachesState::Stale;  // its caches were moved here
+}
 
 IsolatedEntities& IsolatedEntities::operator=(const IsolatedEntities& other) {
   if (&other != this) {
@@ -182,8 +254,13 @@ IsolatedEntities& IsolatedEntities::operator=(const IsolatedEntities& other) {
       throw logic_error{HERE.function_name() +
                         " - Don't assign a group that refers entities from a "
                         "different scenario!"s};
-    _ids = other._ids;
-    byType = other.byType;
+    _mask = other._mask;
+    if (masked) {
+      cachesState = CachesState::Stale;
+    } else {
+      _ids = other._ids;
+      byType = other.byType;
+    }
   }
   return *this;
 }
@@ -193,8 +270,12 @@ IsolatedEntities& IsolatedEntities::operator=(IsolatedEntities&& other) {
       throw logic_error{HERE.function_name() +
                         " - Don't move assign a group that refers entities "
                         "from a different scenario!"s};
+    _mask = other._mask;
+    cachesState = other.cachesState.load();
     _ids = std::move(other._ids);
     byType = std::move(other.byType);
+    if (masked)
+      other.cachesState = CachesState::Stale;  // its caches were moved here
   }
   return *this;
 }
@@ -205,11 +286,23 @@ IsolatedEntities& IsolatedEntities::operator=(
 }
 
 void IsolatedEntities::clear() noexcept {
+  _mask = 0ULL;
+  cachesState = CachesState::Synced;
   _ids.clear();
   byType.clear();
 }
 
 IsolatedEntities& IsolatedEntities::operator+=(unsigned id) {
+  if (masked) {
+    const IdsMask idMask{all->maskOf(id)};
+    if (_mask & idMask)
+      throw domain_error{HERE.function_name() + " - Duplicate entity id: "s +
+                         to_string(id)};
+    _mask |= idMask;
+    cachesState = CachesState::Stale;
+    return *this;
+  }
+
   shared_ptr<const IEntity> ent{(*all)[id]};
   if (!_ids.insert(id).second)
     throw domain_error{HERE.function_name() + " - Duplicate entity id: "s +
@@ -221,6 +314,16 @@ IsolatedEntities& IsolatedEntities::operator+=(unsigned id) {
 }
 
 IsolatedEntities& IsolatedEntities::operator-=(unsigned id) {
+  if (masked) {
+    const IdsMask idMask{all->maskOf(id)};
+    if (!(_mask & idMask))
+      throw domain_error{HERE.function_name() + " - Missing entity id: "s +
+                         to_string(id)};
+    _mask &= ~idMask;
+    cachesState = CachesState::Stale;
+    return *this;
+  }
+
   const string& entType{(*all)[id]->type()};
   if (!_ids.erase(id))
     throw domain_error{HERE.function_name() + " - Missing entity id: "s +
@@ -235,34 +338,98 @@ IsolatedEntities& IsolatedEntities::operator-=(unsigned id) {
 }
 
 bool IsolatedEntities::empty() const noexcept {
+  if (masked)
+    return !_mask;
   return _ids.empty();
 }
 
 size_t IsolatedEntities::count() const noexcept {
+  if (masked)
+    return (size_t)popcount(_mask);
   return size(_ids);
 }
 
 const set<unsigned>& IsolatedEntities::ids() const noexcept {
+  if (cachesState.load(memory_order_acquire) != CachesState::Synced)
+    syncWithMask();
   return _ids;
 }
 
 const map<string, set<unsigned>>& IsolatedEntities::idsByTypes()
     const noexcept {
+  if (cachesState.load(memory_order_acquire) != CachesState::Synced)
+    syncWithMask();
   return byType;
 }
 
+optional<IdsMask> IsolatedEntities::idsMask() const noexcept {
+  if (masked)
+    return _mask;
+  return {};
+}
+
+const AllEntities& IsolatedEntities::pool() const noexcept {
+  return *all;
+}
+
+unsigned IsolatedEntities::countOfType(unsigned typeIdx) const {
+  if (masked)
+    return (unsigned)popcount(_mask & all->typesMasks().at(typeIdx));
+
+  for (const auto& [type, idsOfType] : idsByTypes())
+    if (all->typeIndex(type) == typeIdx)
+      return (unsigned)size(idsOfType);
+  return 0U;
+}
+
+bool IsolatedEntities::operator==(
+    const IsolatedEntities& other) const noexcept {
+  if (sameMaskedPool(other))
+    return _mask == other._mask;
+  return IEntities::operator==(other);
+}
+
+bool IsolatedEntities::sameMaskedPool(
+    const IsolatedEntities& other) const noexcept {
+  return masked && other.masked && all.get() == other.all.get();
+}
+
+void IsolatedEntities::syncWithMask() const {
+  // Concurrent readers of the same group build the caches only once.
+  // The first one builds them, while the others wait just for this group
+  CachesState expected{CachesState::Stale};
+  if (!cachesState.compare_exchange_strong(expected, CachesState::Building,
+                                           memory_order_acquire)) {
+    while (expected == CachesState::Building) {
+      cachesState.wait(CachesState::Building, memory_order_acquire);
+      expected = cachesState.load(memory_order_acquire);
+    }
+    return;
+  }
+
+  _ids.clear();
+  byType.clear();
+  for (IdsMask rest{_mask}; rest; rest &= rest - 1ULL) {
+    const unsigned id{all->idOfBit((unsigned)countr_zero(rest))};
+    _ids.insert(id);
+    byType[(*all)[id]->type()].insert(id);
+  }
+  cachesState.store(CachesState::Synced, memory_order_release);
+  cachesState.notify_all();
+}
+
 bool IsolatedEntities::anyRowCapableEnts(const SymbolsTable& st) const {
-  for (const unsigned id : _ids)
+  for (const unsigned id : ids())
     if ((*all)[id]->canRow(st))
       return true;
   return false;
 }
 
 string IsolatedEntities::toString() const {
-  if (_ids.empty())
+  if (empty())
     return "[]"s;
 
-  return ContView{_ids,
+  return ContView{ids(),
                   {"[ ", ", ", " ]"},
                   [this](unsigned id) {
                     ostringstream oss;
@@ -375,6 +542,10 @@ string MovingEntities::toString() const {
   return oss.str();
 }
 
+BankEntities::BankEntities(const shared_ptr<const AllEntities>& all_,
+                           IdsMask mask_) noexcept
+    : IsolatedEntities{all_, mask_} {}
+
 BankEntities::BankEntities(const BankEntities& other) noexcept
     : IsolatedEntities{other} {}
 
@@ -397,18 +568,43 @@ BankEntities& BankEntities::operator=(const initializer_list<unsigned>& ids_) {
 }
 
 BankEntities& BankEntities::operator+=(const MovingEntities& arrivedEnts) {
+  if (sameMaskedPool(arrivedEnts)) {
+    const IdsMask arrivedMask{*arrivedEnts.idsMask()};
+    if (const IdsMask common{_mask & arrivedMask})
+      throw domain_error{
+          HERE.function_name() + " - Duplicate entity id: "s +
+          to_string(all->idOfBit((unsigned)countr_zero(common)))};
+    _mask |= arrivedMask;
+    cachesState = CachesState::Stale;
+    return *this;
+  }
+
   for (const unsigned id : arrivedEnts.ids())
     IsolatedEntities::operator+=(id);
   return *this;
 }
 
 BankEntities& BankEntities::operator-=(const MovingEntities& leftEnts) {
+  if (sameMaskedPool(leftEnts)) {
+    const IdsMask leftMask{*leftEnts.idsMask()};
+    if (const IdsMask missing{leftMask & ~_mask})
+      throw domain_error{
+          HERE.function_name() + " - Missing entity id: "s +
+          to_string(all->idOfBit((unsigned)countr_zero(missing)))};
+    _mask &= ~leftMask;
+    cachesState = CachesState::Stale;
+    return *this;
+  }
+
   for (const unsigned id : leftEnts.ids())
     IsolatedEntities::operator-=(id);
   return *this;
 }
 
 BankEntities BankEntities::operator~() const noexcept {
+  if (masked)
+    return BankEntities{all, all->fullMask() & ~_mask};
+
   const set<unsigned> allIds{all->ids()}, theseIds{ids()};
   vector<unsigned> restIds;
   ranges::set_difference(allIds, theseIds, back_inserter(restIds));
@@ -420,6 +616,9 @@ size_t BankEntities::differencesCount(
   if (this == &other)
     return 0ULL;
 
+  if (sameMaskedPool(other))
+    return (size_t)popcount(_mask ^ other._mask);
+
   const set<unsigned> theseIds{ids()}, otherIds{other.ids()};
   vector<unsigned> diffIds;
   ranges::set_symmetric_difference(otherIds, theseIds, back_inserter(diffIds));
@@ -16,8 +16,11 @@
 #include "absEntity.h"
 #include "util.h"
 
+#include <atomic>
 #include <concepts>
+#include <cstdint>
 #include <map>
+#include <optional>
 #include <set>
 #include <unordered_map>
 #include <vector>
@@ -26,6 +29,9 @@
 
 namespace rc::ent {
 
+/// Bit mask of a subset of entities. Bit i corresponds to the (i+1)-th entity
+using IdsMask = std::uint64_t;
+
 /// Common interface for handling a set of entities
 class IEntities {
  public:
@@ -95,6 +101,41 @@ class AllEntities : public IEntities {
   [[nodiscard]] const std::vector<unsigned>& idsStartingFromLeftBank()
       const noexcept;
 
+  /// Subsets of these entities can be bit masks only up to this entities count
+  static constexpr size_t MaxMaskedEntities{64ULL};
+
+  /// @return true if subsets of these entities can be expressed as bit masks
+  [[nodiscard]] bool masksAllowed() const noexcept;
+
+  /**
+  @return the mask for the entity with the given id
+  @throw out_of_range if the id is unknown
+  @throw logic_error if there are too many entities for using masks
+  */
+  [[nodiscard]] IdsMask maskOf(unsigned id) const;
+
+  /// @return the id of the entity expressed by the given bit of a mask
+  [[nodiscard]] unsigned idOfBit(unsigned bit) const noexcept;
+
+  /// @return the mask covering all entities
+  [[nodiscard]] IdsMask fullMask() const noexcept;
+
+  /// @return the count of distinct entity types
+  [[nodiscard]] size_t typesCount() const noexcept;
+
+  /**
+  @return the small integer interned for the given type, or nothing for
+  an unknown type. The interned types are 0 .. typesCount()-1
+  */
+  [[nodiscard]] std::optional<unsigned> typeIndex(
+      const std::string& type) const noexcept;
+
+  /**
+  @return the masks of the entities of each interned type
+  @throw logic_error if there are too many entities for using masks
+  */
+  [[nodiscard]] const std::vector<IdsMask>& typesMasks() const;
+
   /// @return the id-s of entities starting on the right bank
   [[nodiscard]] const std::vector<unsigned>& idsStartingFromRightBank()
       const noexcept;
@@ -126,6 +167,14 @@ class AllEntities : public IEntities {
   // Helper fields
   std::unordered_map<unsigned, std::shared_ptr<const IEntity>> byId;
   std::unordered_map<std::string, std::shared_ptr<const IEntity>> byName;
+
+  /// The bit used in masks by each entity (its index within `entities`)
+  std::unordered_map<unsigned, unsigned> bitById;
+  /// The small integer interned for each type, in the order of appearance
+  std::unordered_map<std::string, unsigned> typeIndices;
+
+  /// The masks of the entities of each interned type, while masks are allowed
+  std::vector<IdsMask> _typesMasks;
 };
 
 /// Entities either from a bank or performing the river crossing
@@ -174,6 +223,22 @@ class IsolatedEntities : public IEntities {
   [[nodiscard]] const std::map<std::string, std::set<unsigned>>& idsByTypes()
       const noexcept override;
 
+  /// @return the mask of the ids, or nothing when the pool is too large
+  [[nodiscard]] std::optional<IdsMask> idsMask() const noexcept;
+
+  /// @return the pool of all entities from the scenario
+  [[nodiscard]] const AllEntities& pool() const noexcept;
+
+  /**
+  @return how many entities of the interned type `typeIdx` are in this subset.
+  For masks it's a popcount, without building the ids grouped by types
+  */
+  [[nodiscard]] unsigned countOfType(unsigned typeIdx) const;
+
+  /// Compares this subset against another
+  [[nodiscard]] bool operator==(const IsolatedEntities& other) const noexcept;
+  using IEntities::operator==;
+
   /// Are there any entities capable to row within the context specified by st?
   [[nodiscard]] bool anyRowCapableEnts(const SymbolsTable& st) const;
 
@@ -184,18 +249,53 @@ class IsolatedEntities : public IEntities {
       template <class IdsCont = std::vector<unsigned>>
       explicit IsolatedEntities(const std::shared_ptr<const AllEntities>& all_,
                                 const IdsCont& ids_ = {})
-      : all(all_) {
+      : all(all_), masked{all->masksAllowed()} {
     for (const unsigned id : ids_)
       operator+=(id);
   }
 
+  /// Subset of a pool allowing masks, expressed by the provided mask
+  IsolatedEntities(const std::shared_ptr<const AllEntities>& all_,
+                   IdsMask mask_) noexcept;
+
+  /// @return true if both subsets are masks over the same pool
+  [[nodiscard]] bool sameMaskedPool(
+      const IsolatedEntities& other) const noexcept;
+
+  /// Rebuilds _ids and byType from _mask
+  void syncWithMask() const;
+
   /// All entities from the scenario
   gsl::not_null<std::shared_ptr<const AllEntities>> all;
 
-  std::set<unsigned> _ids;  ///< the ids of a subset of all entities
+  /**
+  Are the ids kept in _mask?
+  Then _ids and byType are just caches built on demand.
+  Otherwise (too many entities in the pool), _mask is not used.
+  */
+  bool masked;
+
+  IdsMask _mask{};  ///< the ids of a subset of all entities, as bits
+
+  /// States of the caches _ids and byType of a masked subset
+  enum class CachesState : unsigned char {
+    Stale,     ///< to be rebuilt from _mask
+    Building,  ///< being rebuilt by some thread
+    Synced     ///< up to date
+  };
+
+  /**
+  Are _ids and byType up to date?
+  Atomic, since parallel solvers may share const groups whose caches
+  get built on demand by syncWithMask.
+  */
+  mutable std::atomic<CachesState> cachesState{CachesState::Synced};
+
+  /// the ids of a subset of all entities
+  mutable std::set<unsigned> _ids;
 
   /// the subset of entities ids grouped by type
-  std::map<std::string, std::set<unsigned>> byType;
+  mutable std::map<std::string, std::set<unsigned>> byType;
 };
 
 /// Interface for the extensions for each group of entities moving to the other
@@ -383,7 +483,7 @@ class MovingEntities : public IsolatedEntities {
                               std::make_unique<DefMovingEntitiesExt>())
       : IsolatedEntities{all_, ids_},
         extension{gsl::not_null<IMovingEntitiesExt*>(extension_.release())} {
-    extension->newGroup(_ids);
+    extension->newGroup(ids());
   }
 
   MovingEntities(const MovingEntities& other) noexcept;
@@ -404,7 +504,7 @@ class MovingEntities : public IsolatedEntities {
     IsolatedEntities::operator=(ids_);
 
     // no redundant previous extension->addEntity(id) calls
-    extension->newGroup(_ids);
+    extension->newGroup(ids());
     return *this;
   }
 
@@ -443,6 +543,10 @@ class BankEntities : public IsolatedEntities {
                         const IdsCont& ids_ = {})
       : IsolatedEntities{all_, ids_} {}
 
+  /// Subset of a pool allowing masks, expressed by the provided mask
+  BankEntities(const std::shared_ptr<const AllEntities>& all_,
+               IdsMask mask_) noexcept;
+
   BankEntities(const BankEntities& other) noexcept;
   BankEntities(BankEntities&& other) noexcept;
   BankEntities& operator=(const BankEntities& other);
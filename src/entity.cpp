@@ -26,13 +26,17 @@
 #endif  // UNIT_TESTING defined
 
 #include "absConfigConstraint.h"
+#include "configConstraint.h"
 #include "configParser.h"
 #include "entity.h"
 #include "util.h"
 
 #include <cassert>
+#include <memory>
+#include <optional>
 #include <sstream>
 #include <string>
+#include <vector>
 
 using namespace std;
 using namespace boost::property_tree;
@@ -51,6 +55,23 @@ gsl::not_null<shared_ptr<const rc::cond::LogicalExpr>> canRowSemantic(
                    "CanRow parsing error! See the cause above.");
 }
 
+/// @return the compiled form of canRow or NULL if it can't be compiled
+shared_ptr<const rc::cond::ExprProgram> canRowProgramOf(
+    const rc::cond::LogicalExpr& canRow) {
+  optional<rc::cond::ExprProgram> program{
+      rc::cond::ExprProgram::compile(canRow)};
+  if (!program)
+    return {};
+  return make_shared<const rc::cond::ExprProgram>(std::move(*program));
+}
+
+/// @return canRow tabulated by CrossingIndex or empty if it's not possible
+vector<bool> canRowTableOf(const rc::cond::LogicalExpr& canRow) {
+  if (canRow.constValue())
+    return {};
+  return rc::cond::tabulateByCrossingIndex(canRow);
+}
+
 }  // anonymous namespace
 
 namespace rc::ent {
@@ -64,6 +85,8 @@ Entity::Entity(unsigned id_,
     : _name{name_},
       _type{type_},
       _canRow{canRowSemantic(canRowExpr)},
+      canRowProgram{canRowProgramOf(*_canRow)},
+      canRowTable{canRowTableOf(*_canRow)},
       _weight{weight_},
       _id{id_},
       _startsFromRightBank{startsFromRightBank_} {
@@ -120,6 +143,8 @@ Entity::Entity(const ptree& ent) : _type{ent.get("Type", ""s)} {
         to_string(_id)};
   _canRow = canRowSemantic(canRowExpr);
   assert(_canRow);
+  canRowProgram = canRowProgramOf(*_canRow);
+  canRowTable = canRowTableOf(*_canRow);
 }
 
 unsigned Entity::id() const noexcept {
@@ -135,9 +160,19 @@ bool Entity::startsFromRightBank() const noexcept {
 }
 
 bool Entity::canRow(const SymbolsTable& st) const {
+  if (canRowProgram)
+    return canRowProgram->run(st) != 0.;
   return _canRow->eval(st);
 }
 
+const vector<bool>& Entity::canRowByCrossingIndex() const noexcept {
+  return canRowTable;
+}
+
+string Entity::canRowExpr() const {
+  return _canRow->toString();
+}
+
 boost::logic::tribool Entity::canRow() const noexcept {
   using namespace boost::logic;
   if (!_canRow->constValue())
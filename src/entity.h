@@ -15,6 +15,8 @@
 
 #include "absConfigConstraint.h"
 
+#include <vector>
+
 #include <boost/property_tree/ptree.hpp>
 
 namespace rc::ent {
@@ -62,6 +64,17 @@ class Entity : public IEntity {
   */
   [[nodiscard]] boost::logic::tribool canRow() const noexcept override;
 
+  /**
+   @return the row-ability of the entity for each residue of `CrossingIndex`
+   modulo the size of the result. Empty when the ability is constant or when
+   it isn't a periodic function of `CrossingIndex` alone
+  */
+  [[nodiscard]] const std::vector<bool>& canRowByCrossingIndex()
+      const noexcept override;
+
+  /// @return the expression deciding if the entity is able to row
+  [[nodiscard]] std::string canRowExpr() const override;
+
   /// Type of entity; '' if unspecified
   [[nodiscard]] const std::string& type() const noexcept override;
 
@@ -79,6 +92,12 @@ class Entity : public IEntity {
   /// Whether the entity can row / move by itself to the other bank
   std::shared_ptr<const cond::LogicalExpr> _canRow;
 
+  /// The compiled form of _canRow or NULL if it can't be compiled
+  std::shared_ptr<const cond::ExprProgram> canRowProgram;
+
+  /// _canRow tabulated by the residues of `CrossingIndex` when possible
+  std::vector<bool> canRowTable;
+
   double _weight{};  ///< weight of the entity - optional
   unsigned _id{};    ///< id of the entity - mandatory
 
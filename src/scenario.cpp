@@ -30,13 +30,40 @@
 #include "transferredLoadExt.h"
 #include "util.h"
 
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <chrono>
 #include <climits>
 #include <cmath>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <random>
 #include <ranges>
+#include <string_view>
+#include <thread>
 #include <tuple>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <boost/property_tree/json_parser.hpp>
 
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#define PSAPI_VERSION 2  // GetProcessMemoryInfo from kernel32
+#include <windows.h>
+
+#include <psapi.h>
+#include <fcntl.h>
+#include <io.h>
+
+#elif __has_include(<sys/resource.h>)
+#include <sys/resource.h>
+
+#endif  // _WIN32 or <sys/resource.h> available
+
 using namespace std;
 namespace fs = std::filesystem;
 using namespace fs;
@@ -91,6 +118,49 @@ void duplicateKeyExc(const vector<string>& keys) {
                    "NightMode parsing error! See the cause above.");
 }
 
+/// Writes text to os as a JSON string
+void writeJsonString(ostream& os, string_view text) {
+  os << '"';
+  for (const char c : text) {
+    if (c == '"' || c == '\\')
+      os << '\\' << c;
+    else if ((unsigned char)c < 0x20U) {
+      // Local formatting, to leave the flags and the fill of os unchanged
+      static constexpr char HexDigits[]{"0123456789abcdef"};
+      os << "\\u00" << HexDigits[(unsigned char)c >> 4U]
+         << HexDigits[(unsigned char)c & 0xFU];
+    } else
+      os << c;
+  }
+  os << '"';
+}
+
+/**
+Writes pt to os as compact JSON. Like write_json, it presents all values as
+strings and the nodes whose children have only empty keys as arrays.
+*/
+void writeJson(ostream& os, const ptree& pt) {
+  if (pt.empty()) {
+    writeJsonString(os, pt.data());
+    return;
+  }
+
+  const bool isArray{pt.count("") == pt.size()};
+  os << (isArray ? '[' : '{');
+  bool first{true};
+  for (const auto& [key, child] : pt) {
+    if (!first)
+      os << ',';
+    first = false;
+    if (!isArray) {
+      writeJsonString(os, key);
+      os << ':';
+    }
+    writeJson(os, child);
+  }
+  os << (isArray ? ']' : '}');
+}
+
 using namespace rc;
 using namespace rc::ent;
 using namespace rc::cond;
@@ -503,8 +573,8 @@ Scenario::Scenario(istream& scenarioStream,
       }
 
       try {
-        details.banksConstraints = make_unique<const ConfigConstraints>(
-            std::move(*readConstraints), *entities, allowed);
+        details.banksConstraints = make_unique<const BanksConstraints>(
+            std::move(*readConstraints), entities, allowed);
       } catch (const logic_error& e) {
         throw domain_error{e.what()};
       }
@@ -570,65 +640,238 @@ void Scenario::outputResults(const Results& res,
         "based on the requested algorithm!"s};
 
   if (!interactiveSol || !res.attempt->isSolution()) {
-    cout << "Considered scenario:\n" << *this << "\n\n";
-    cout << res;
+    ostringstream oss;
+    oss << res;
+    outputResultsText(oss.str());
     return;
   }
 
-  const unsigned solLen{(unsigned)res.attempt->length()};
-  const shared_ptr<const sol::IState> initialState{res.attempt->initialState()};
-  SymbolsTable st{InitialSymbolsTable()};
+  outputInteractive(
+      [this, &res](ostream& os) { writeInteractiveMoves(os, res); });
+}
 
-  ptree root, movesTree;
+void Scenario::outputResultsText(const string& results) const {
+  cout << "Considered scenario:\n" << *this << "\n\n";
+  cout << results;
+}
 
-  root.put_child("ScenarioDescription", descrTree);
+void Scenario::writeInteractiveMoves(ostream& os, const Results& res) const {
+  assert(res.attempt && res.attempt->isSolution());
 
-  if (bridgeInsteadOfRaft)
-    root.put("Bridge", "true");
+  const unsigned solLen{(unsigned)res.attempt->length()};
+  SymbolsTable st{InitialSymbolsTable()};
 
-  root.put_child("Entities", entTree);
+  // The ids appear as strings, like in the Entities section
+  unordered_map<unsigned, string> idsJson;
+  for (const unsigned id : details.entities->ids())
+    idsJson.emplace(id, '"' + to_string(id) + '"');
 
-  const auto addEntsSet = [](ptree& pt, const IsolatedEntities& ents,
-                             const string& propName) {
-    ptree idsTree;
+  const auto writeEntsSet = [&os, &idsJson](const IsolatedEntities& ents,
+                                            string_view propName) {
+    os << ",\"" << propName << "\":[";
+    bool first{true};
     for (const unsigned id : ents.ids()) {
-      ptree idTree;
-      idTree.put_value(id);
-      idsTree.push_back(make_pair("", idTree));
+      if (!first)
+        os << ',';
+      first = false;
+      os << idsJson.at(id);
     }
-    pt.put_child(propName, idsTree);
+    os << ']';
   };
 
-  const auto addMove = [this, &addEntsSet, &movesTree, &st](
-                           shared_ptr<const sol::IState> state,
-                           const IsolatedEntities* moved = {}) {
-    const string otherDetails{state->getExtension()->detailsForDemo()};
-
-    ptree moveTree;
-    moveTree.put("Idx", st["CrossingIndex"]++);
+  const auto writeMove = [this, &os, &st, &writeEntsSet](
+                             const sol::IState& state,
+                             const IsolatedEntities* moved = {}) {
+    os << "{\"Idx\":\"" << st[SymbolsTable::CrossingIndexSlot]++ << '"';
     if (nightMode->eval(st))
-      moveTree.put("NightMode", true);
+      os << ",\"NightMode\":\"true\"";
     if (moved)
-      addEntsSet(moveTree, *moved, "Transferred");
-    addEntsSet(moveTree, state->leftBank(), "LeftBank");
-    addEntsSet(moveTree, state->rightBank(), "RightBank");
-    if (!otherDetails.empty())
-      moveTree.put("OtherDetails", otherDetails);
-    movesTree.push_back(make_pair("", moveTree));
+      writeEntsSet(*moved, "Transferred");
+    writeEntsSet(state.leftBank(), "LeftBank");
+    writeEntsSet(state.rightBank(), "RightBank");
+    if (const string otherDetails{state.getExtension()->detailsForDemo()};
+        !otherDetails.empty()) {
+      os << ",\"OtherDetails\":";
+      writeJsonString(os, otherDetails);
+    }
+    os << '}';
   };
 
-  addMove(initialState);
-
+  os << '[';
+  writeMove(*res.attempt->initialState());
   for (unsigned step{}; step < solLen; ++step) {
     const sol::IMove& aMove{res.attempt->move(step)};
-    const shared_ptr<const sol::IState> resultedState{aMove.resultedState()};
+    os << ',';
+    writeMove(*aMove.resultedState(), &aMove.movedEntities());
+  }
+  os << ']';
+}
+
+void Scenario::outputInteractive(
+    const function<void(ostream&)>& writeMoves) const {
+  cout << "{\"ScenarioDescription\":";
+  writeJson(cout, descrTree);
+
+  if (bridgeInsteadOfRaft)
+    cout << ",\"Bridge\":\"true\"";
+
+  cout << ",\"Entities\":";
+  writeJson(cout, entTree);
+
+  cout << ",\"Moves\":";
+  writeMoves(cout);
+  cout << "}\n";
+}
+
+string Scenario::cacheKey(Algorithm algorithm, unsigned threadsCount) const {
+  // The description and the images of the entities don't influence
+  // the exploration, unlike the rest of the details and the night mode
+  ostringstream oss;
+  oss << "Format: " << SolutionsCache::FormatVersion << '\n'
+      << details.canonicalForm() << "\nNightMode: " << *nightMode
+      << "\nBridge: " << boolalpha << bridgeInsteadOfRaft
+      << "\nAlgorithm: " << (int)algorithm << "\nThreads: " << threadsCount;
+  return oss.str();
+}
 
-    addMove(aMove.resultedState(), &aMove.movedEntities());
+bool Scenario::cachedSolution(const SolutionsCache& cache,
+                              Algorithm algorithm,
+                              bool interactiveSol /* = false*/,
+                              unsigned threadsCount /* = 1U*/) {
+  const string key{cacheKey(algorithm, threadsCount)};
+  if (const optional<SolutionsCache::Outcome> known{cache.find(key)}) {
+    if (!interactiveSol || !known->solved)
+      outputResultsText(known->results);
+    else if (!known->moves.empty())
+      outputInteractive([&known](ostream& os) { os << known->moves; });
+    else
+      cerr << "Unable to prepare the solution animation!" << endl;
+
+    return known->solved;
+  }
+
+  const Results& res{solution(algorithm, interactiveSol, threadsCount)};
+  SolutionsCache::Outcome outcome;
+  outcome.solved = res.attempt->isSolution();
+  ostringstream oss;
+  oss << res;
+  outcome.results = oss.str();
+  if (outcome.solved) {
+    try {
+      ostringstream movesStream;
+      writeInteractiveMoves(movesStream, res);
+      outcome.moves = movesStream.str();
+    } catch (const exception&) {
+      // Only the interactive visualization remains unavailable
+    }
   }
+  cache.store(key, outcome);
+
+  return outcome.solved;
+}
+
+SolutionsCache::SolutionsCache(fs::path dir_,
+                               size_t capacity_ /* = DefaultCapacity*/)
+    : dir{std::move(dir_)}, capacity{capacity_} {
+  if (!capacity)
+    throw invalid_argument{HERE.function_name() +
+                           " - The capacity must be at least 1!"s};
 
-  root.put_child("Moves", movesTree);
+  error_code ec;
+  create_directories(dir, ec);
+}
+
+fs::path SolutionsCache::fileOf(const string& key) const {
+  // 64-bit FNV-1a, unlike std::hash, doesn't depend on the standard library
+  uint64_t digest{14'695'981'039'346'656'037ULL};
+  for (const char c : key) {
+    digest ^= (unsigned char)c;
+    digest *= 1'099'511'628'211ULL;
+  }
 
-  write_json(cout, root);
+  ostringstream oss;
+  oss << hex << setw(16) << setfill('0') << digest << ".json";
+  return dir / oss.str();
+}
+
+optional<SolutionsCache::Outcome> SolutionsCache::find(
+    const string& key) const {
+  const fs::path file{fileOf(key)};
+  error_code ec;
+  if (!exists(file, ec))
+    return nullopt;
+
+  ptree entry;
+  try {
+    ifstream ifs{file, ios::binary};
+    read_json(ifs, entry);
+  } catch (const json_parser_error&) {
+    remove(file, ec);  // corrupted entry
+    return nullopt;
+  }
+
+  if (entry.get("Key", ""s) != key)
+    return nullopt;  // hash collision
+
+  Outcome outcome;
+  outcome.results = entry.get("Results", ""s);
+  outcome.moves = entry.get("Moves", ""s);
+  outcome.solved = entry.get("Solved", false);
+
+  last_write_time(file, fs::file_time_type::clock::now(), ec);
+  return outcome;
+}
+
+void SolutionsCache::store(const string& key, const Outcome& outcome) const {
+  ptree entry;
+  entry.put("Key", key);
+  entry.put("Solved", outcome.solved);
+  entry.put("Results", outcome.results);
+  if (!outcome.moves.empty())
+    entry.put("Moves", outcome.moves);
+
+  // Concurrent solvers might store the same outcome.
+  // Each writes its own temporary file and then renames it
+  const fs::path file{fileOf(key)};
+  fs::path tempFile{file};
+  tempFile += "."s + to_string(random_device{}()) + ".tmp";
+  try {
+    {
+      ofstream ofs{tempFile, ios::binary};
+      write_json(ofs, entry, false);
+    }
+    rename(tempFile, file);
+  } catch (const exception&) {
+    error_code ec;
+    remove(tempFile, ec);
+    return;
+  }
+
+  evict();
+}
+
+void SolutionsCache::evict() const {
+  vector<pair<fs::file_time_type, fs::path>> entries;
+  error_code ec;
+  for (directory_iterator it{dir, ec}, itEnd; !ec && it != itEnd;
+       it.increment(ec)) {
+    if (it->path().extension() != ".json")
+      continue;
+
+    error_code timeEc;
+    const fs::file_time_type lastUse{it->last_write_time(timeEc)};
+    if (!timeEc)
+      entries.emplace_back(lastUse, it->path());
+  }
+
+  if (size(entries) <= capacity)
+    return;
+
+  // The most recently used first
+  const auto keptEnd{next(begin(entries), (ptrdiff_t)capacity)};
+  ranges::nth_element(entries, keptEnd, greater{});
+  for (auto it{keptEnd}; it != end(entries); ++it)
+    remove(it->second, ec);
 }
 
 shared_ptr<const cond::IContextValidator>
@@ -654,16 +897,58 @@ void ScenarioDetails::createTransferConstraintsExt() {
       make_unique<const MaxLoadTransferConstraintsExt>(maxLoad, std::move(res));
 }
 
-unique_ptr<ent::IMovingEntitiesExt> ScenarioDetails::createMovingEntitiesExt()
-    const {
+unique_ptr<ent::IMovingEntitiesExt> ScenarioDetails::createMovingEntitiesExt(
+    optional<unsigned> crossingDuration /* = {}*/) const {
   unique_ptr<ent::IMovingEntitiesExt> res{make_unique<DefMovingEntitiesExt>()};
 
+  if (!ctdItems.empty())
+    res = make_unique<CrossingDurationExt>(entities, crossingDuration,
+                                           std::move(res));
+
   if (!allowedLoads && maxLoad == DBL_MAX)
     return res;
 
   return make_unique<TotalLoadExt>(entities, 0., std::move(res));
 }
 
+optional<unsigned> ScenarioDetails::crossingDurationOf(
+    const ent::IsolatedEntities& ents) const {
+  for (const ConfigurationsTransferDuration& ctdItem : ctdItems)
+    if (ctdItem.configConstraints().ConfigConstraints::check(ents))
+      return ctdItem.duration();
+  return {};
+}
+
+vector<IdsMask> ScenarioDetails::interchangeableEntities() const {
+  if (!entities || !entities->masksAllowed())
+    return {};
+
+  unordered_set<unsigned> mentionedIds;
+  if (transferConstraints)
+    transferConstraints->addMentionedIdsTo(mentionedIds);
+  if (banksConstraints)
+    banksConstraints->addMentionedIdsTo(mentionedIds);
+  for (const cond::ConfigurationsTransferDuration& ctdItem : ctdItems)
+    ctdItem.configConstraints().addMentionedIdsTo(mentionedIds);
+
+  // The traits distinguishing the entities not mentioned individually
+  map<tuple<string, double, bool, string>, IdsMask> groups;
+  for (const unsigned id : entities->ids()) {
+    if (mentionedIds.contains(id))
+      continue;
+
+    const shared_ptr<const IEntity> entity{(*entities)[id]};
+    groups[{entity->type(), entity->weight(), entity->startsFromRightBank(),
+            entity->canRowExpr()}] |= entities->maskOf(id);
+  }
+
+  vector<IdsMask> result;
+  for (const IdsMask group : groups | views::values)
+    if (popcount(group) > 1)
+      result.push_back(group);
+  return result;
+}
+
 void Scenario::Results::update(size_t attemptLen,
                                size_t crtDistToSol,
                                const ent::BankEntities& currentLeftBank,
@@ -722,6 +1007,242 @@ string ScenarioDetails::toString() const {
   return oss.str();
 }
 
+string ScenarioDetails::canonicalForm() const {
+  ostringstream oss;
+  oss << boolalpha << setprecision(numeric_limits<double>::max_digits10);
+  if (entities)
+    for (const unsigned id : entities->ids()) {
+      const IEntity& entity{*(*entities)[id]};
+      oss << "Entity " << id << " {Name: `" << entity.name() << "`, Type: `"
+          << entity.type() << "`, Weight: " << entity.weight()
+          << ", StartsFromRightBank: " << entity.startsFromRightBank()
+          << ", CanRow: `" << entity.canRowExpr() << "`}\n";
+    }
+
+  oss << "Capacity: " << capacity << "\nMaxLoad: " << maxLoad;
+  if (transferConstraints)
+    oss << "\nTransferConstraints: " << *transferConstraints;
+  if (allowedLoads)
+    oss << "\nAllowedLoads: `" << *allowedLoads << '`';
+  for (const ConfigurationsTransferDuration& ctd : ctdItems)
+    oss << "\nCrossingDuration: " << ctd;
+  if (banksConstraints)
+    oss << "\nBanksConstraints: " << *banksConstraints;
+  oss << "\nTimeLimit: " << maxDuration;
+
+  return oss.str();
+}
+
+namespace {
+
+/// Redirects the standard output and error into a buffer while in scope
+class OutputCapture {
+ public:
+  OutputCapture() noexcept
+      : oldCout{cout.rdbuf(captured.rdbuf())},
+        oldCerr{cerr.rdbuf(captured.rdbuf())} {}
+  ~OutputCapture() noexcept {
+    cout.rdbuf(oldCout);
+    cerr.rdbuf(oldCerr);
+  }
+
+  OutputCapture(const OutputCapture&) = delete;
+  OutputCapture(OutputCapture&&) = delete;
+  void operator=(const OutputCapture&) = delete;
+  void operator=(OutputCapture&&) = delete;
+
+  /// Everything written to cout and cerr so far
+  [[nodiscard]] string text() const { return captured.str(); }
+
+ private:
+  ostringstream captured;
+  streambuf* oldCout;
+  streambuf* oldCerr;
+};
+
+/**
+Solves the scenario, looking first for its outcome in the cache, if provided
+@return true if the scenario has a solution
+*/
+[[nodiscard]] bool solve(Scenario& scenario,
+                         const SolutionsCache* cache,
+                         Scenario::Algorithm algorithm,
+                         bool interactive,
+                         unsigned threadsCount) {
+  if (cache)
+    return scenario.cachedSolution(*cache, algorithm, interactive,
+                                   threadsCount);
+
+  return scenario.solution(algorithm, interactive, threadsCount)
+      .attempt->isSolution();
+}
+
+/// @return the peak memory of the process so far in KiB, when available
+[[nodiscard]] optional<size_t> peakMemoryKiB() noexcept {
+#if defined _WIN32
+  PROCESS_MEMORY_COUNTERS counters{};
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof counters))
+    return nullopt;
+  return counters.PeakWorkingSetSize / 1'024ULL;
+
+#elif __has_include(<sys/resource.h>)
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage))
+    return nullopt;
+#ifdef __APPLE__
+  return (size_t)usage.ru_maxrss / 1'024ULL;  // bytes on macOS
+#else
+  return (size_t)usage.ru_maxrss;  // already KiB
+#endif  // __APPLE__
+
+#else
+  return nullopt;
+
+#endif  // _WIN32 or <sys/resource.h> available
+}
+
+/// `serve` rejects the scenarios larger than this many bytes
+constexpr size_t MaxServedScenarioSize{16ULL << 20U};
+
+/// @return text as a JSON string
+[[nodiscard]] string jsonString(string_view text) {
+  ostringstream oss;
+  writeJsonString(oss, text);
+  return oss.str();
+}
+
+}  // anonymous namespace
+
+void serve(istream& in,
+           ostream& out,
+           const SolutionsCache* cache,
+           Scenario::Algorithm algorithm,
+           unsigned threadsCount) {
+  const auto answer = [&out](int exitCode, const string& output) {
+    out << exitCode << ' ' << size(output) << '\n' << output << flush;
+  };
+
+  for (string header; getline(in, header);) {
+    istringstream headerStream{header};
+    string sizeText, mode, extra;
+    if (!(headerStream >> sizeText))
+      continue;  // ignore blank lines between frames
+
+    size_t scenarioSize{};
+    const char* const sizeEnd{data(sizeText) + size(sizeText)};
+    if (const auto [parsedEnd, parseError] =
+            from_chars(data(sizeText), sizeEnd, scenarioSize);
+        parseError != errc{} || parsedEnd != sizeEnd) {
+      // The scenario cannot be skipped without knowing its size, so the next
+      // frames would be unreadable
+      answer(-1, "Invalid request header: "s + header + '\n');
+      return;
+    }
+
+    string error;
+    headerStream >> mode >> extra;
+    if ((!mode.empty() && mode != "interactive") || !extra.empty())
+      error = "Invalid request header: "s + header;
+    else if (scenarioSize > MaxServedScenarioSize)
+      error = "Scenarios larger than "s + to_string(MaxServedScenarioSize) +
+              " bytes aren't accepted! Request header: "s + header;
+    if (!error.empty()) {
+      // Skipping the scenario keeps the next frames readable
+      in.ignore((streamsize)min(scenarioSize,
+                                (size_t)numeric_limits<streamsize>::max()));
+      answer(-1, error + '\n');
+      continue;
+    }
+
+    string scenarioText(scenarioSize, '\0');
+    if (!in.read(data(scenarioText), (streamsize)scenarioSize)) {
+      answer(-1, "Truncated scenario in the last request!\n"s);
+      return;
+    }
+
+    int exitCode{-1};
+    string output;
+    {
+      const OutputCapture capture;
+      try {
+        istringstream scenarioStream{scenarioText};
+        Scenario scenario{scenarioStream, /*solveNow = */ false};
+        if (solve(scenario, cache, algorithm, !mode.empty(), threadsCount))
+          exitCode = 0;
+      } catch (const exception& e) {
+        cerr << e.what() << endl;
+      }
+      output = capture.text();
+    }
+
+    answer(exitCode, output);
+  }
+}
+
+bool solveBatch(const vector<fs::path>& files,
+                ostream& out,
+                unsigned jobsCount,
+                Scenario::Algorithm algorithm,
+                unsigned threadsCount,
+                size_t maxDfsProbes /* = SIZE_MAX*/) {
+  atomic<size_t> nextFile{};
+  atomic_bool allSolved{true};
+  mutex outGuard;
+
+  const auto solveFiles = [&] {
+    for (size_t i{nextFile++}; i < size(files); i = nextFile++) {
+      const fs::path& file{files[i]};
+      ostringstream record;
+      record << "{\"file\": " << jsonString(file.string());
+
+      const auto start{chrono::steady_clock::now()};
+      try {
+        ifstream ifs{file};
+        if (!ifs)
+          throw runtime_error{HERE.function_name() +
+                              " - Couldn't open the scenario file!"s};
+
+        Scenario scenario{ifs, /*solveNow = */ false};
+        const Scenario::Results& res{
+            scenario.explore(algorithm, threadsCount, maxDfsProbes)};
+        const bool solved{res.attempt->isSolution()};
+        record << ", \"solved\": " << boolalpha << solved;
+        if (solved)
+          record << ", \"solutionLength\": " << res.attempt->length();
+        else
+          allSolved = false;
+        if (res.interrupted)
+          record << ", \"interrupted\": true";
+        record << ", \"investigatedStates\": " << res.investigatedStates
+               << ", \"longestInvestigatedPath\": "
+               << res.longestInvestigatedPath;
+      } catch (const exception& e) {
+        record << ", \"error\": " << jsonString(e.what());
+        allSolved = false;
+      }
+      const chrono::duration<double, milli> elapsed{
+          chrono::steady_clock::now() - start};
+      record << ", \"wallTimeMs\": " << fixed << setprecision(3)
+             << elapsed.count();
+      if (const optional<size_t> peak{peakMemoryKiB()})
+        record << ", \"processPeakMemoryKiB\": " << *peak;
+      record << "}\n";
+
+      const lock_guard lock{outGuard};
+      out << record.str() << flush;
+    }
+  };
+
+  {
+    vector<jthread> workers;
+    for (unsigned job{1U}; job < jobsCount; ++job)
+      workers.emplace_back(solveFiles);
+    solveFiles();
+  }  // joins the workers
+
+  return allSolved;
+}
+
 }  // namespace rc
 
 namespace std {
@@ -748,8 +1269,6 @@ ostream& operator<<(ostream& os, const rc::Scenario::Results& o) {
 
 #ifndef UNIT_TESTING
 
-#include <fstream>
-
 // GSL before 4.1.0 doesn't have <gsl/zstring>
 #if __has_include(<gsl/zstring>)
 #include <gsl/zstring>
@@ -764,6 +1283,14 @@ using namespace gsl;
 
 namespace {
 
+/// The accepted arguments, reported for an unknown argument
+constexpr string_view Usage{
+    "Usage: RiverCrossing [interactive] [threads=N] "
+    "[algorithm=bfs|dfs|astar|ucs|bibfs] [cache=DIR] < scenario.json\n"
+    "       RiverCrossing serve [threads=N] [algorithm=...] [cache=DIR]\n"
+    "       RiverCrossing batch [jobs=N] [probes=N] [threads=N] "
+    "[algorithm=...] [scenario files]"};
+
 /// Settings for the project
 class Config {
  public:
@@ -807,18 +1334,145 @@ int main(int argc, zstring* argv) try {
 
   std::span<zstring> args{argv, (size_t)argc};
 
-  const bool interactive{(size(args) >= 2ULL) &&
-                         (!strcmp("interactive", args[1ULL]))};
+  // Accepted arguments (in any order):
+  // - interactive - for the interactive visualization of the solution
+  // - threads=N - the BFS uses N threads (all available cores for N = 0)
+  // - algorithm=bfs|dfs|astar|ucs|bibfs - BFS when missing
+  // - serve - solves the framed scenarios from stdin until its end
+  //   (see rc::serve()); `interactive` is then chosen per request
+  // - cache=DIR - reuses the outcomes of the scenarios explored before,
+  //   which are stored in folder DIR (see SolutionsCache)
+  // - batch - explores the scenario files provided as the other arguments
+  //   (all from the Scenarios folder when none) and writes a JSON line with
+  //   the statistics of each (see rc::solveBatch())
+  // - jobs=N - batch mode explores N scenarios at once (all available cores
+  //   when missing or for N = 0)
+  // - probes=N - batch mode stops each DFS after probing N raft/bridge
+  //   configurations and reports it as interrupted (unlimited when missing)
+  // jobs=N and probes=N are rejected outside the batch mode, while
+  // interactive and cache=DIR are rejected within it
+  bool interactive{}, serving{}, batch{};
+  unsigned threadsCount{1U}, jobsCount{};
+  size_t maxDfsProbes{SIZE_MAX};
+  Scenario::Algorithm algorithm{Scenario::Algorithm::BFS};
+  optional<fs::path> cacheDir;
+  vector<fs::path> batchFiles;
+  static constexpr string_view threadsPrefix{"threads="},
+      algorithmPrefix{"algorithm="}, cachePrefix{"cache="}, jobsPrefix{"jobs="},
+      probesPrefix{"probes="};
+  static const map<string_view, Scenario::Algorithm> algorithms{
+      {"bfs", Scenario::Algorithm::BFS},
+      {"dfs", Scenario::Algorithm::DFS},
+      {"astar", Scenario::Algorithm::AStar},
+      {"ucs", Scenario::Algorithm::UniformCost},
+      {"bibfs", Scenario::Algorithm::BidirectionalBFS}};
+
+  // The count N from argument `arg` of the form `prefix`N, which cannot exceed
+  // `maxCount`. Reports a malformed N together with the usage
+  const auto countOf = [](string_view arg, string_view prefix,
+                          unsigned long long maxCount) {
+    const string_view countText{arg.substr(size(prefix))};
+    const char* const countEnd{data(countText) + size(countText)};
+    unsigned long long count{};
+    if (const auto [parsedEnd, parseError] =
+            from_chars(data(countText), countEnd, count);
+        parseError != errc{} || parsedEnd != countEnd || count > maxCount)
+      throw invalid_argument{"Invalid argument: "s + string{arg} + '\n' +
+                             string{Usage}};
+    return count;
+  };
+
+  bool batchOnlyArgs{};  // were there any `jobs=` or `probes=` arguments?
+  for (const string_view arg : args.subspan(1ULL)) {
+    if (arg == "interactive")
+      interactive = true;
+    else if (arg == "serve")
+      serving = true;
+    else if (arg == "batch")
+      batch = true;
+    else if (arg.starts_with(jobsPrefix)) {
+      jobsCount = (unsigned)countOf(arg, jobsPrefix, UINT_MAX);
+      batchOnlyArgs = true;
+    } else if (arg.starts_with(probesPrefix)) {
+      maxDfsProbes = (size_t)countOf(arg, probesPrefix, SIZE_MAX);
+      batchOnlyArgs = true;
+    } else if (arg.starts_with(threadsPrefix)) {
+      threadsCount = (unsigned)countOf(arg, threadsPrefix, UINT_MAX);
+      if (!threadsCount)
+        threadsCount = max(thread::hardware_concurrency(), 1U);
+    } else if (arg.starts_with(algorithmPrefix)) {
+      const auto it = algorithms.find(arg.substr(size(algorithmPrefix)));
+      if (it == cend(algorithms))
+        throw invalid_argument{"Unknown argument: "s + string{arg} + '\n' +
+                               string{Usage}};
+      algorithm = it->second;
+    } else if (arg.starts_with(cachePrefix))
+      cacheDir.emplace(arg.substr(size(cachePrefix)));
+    else
+      batchFiles.emplace_back(arg);
+  }
+
+  if (batchOnlyArgs && !batch)
+    throw invalid_argument{"Arguments `jobs=` and `probes=` need `batch`\n"s +
+                           string{Usage}};
+  if (batch && (interactive || cacheDir))
+    throw invalid_argument{
+        "Arguments `interactive` and `cache=` don't work with `batch`\n"s +
+        string{Usage}};
+
+  // Only the batch mode accepts scenario files, which must exist
+  for (const fs::path& file : batchFiles) {
+    if (!batch)
+      throw invalid_argument{"Unknown argument: "s + file.string() + '\n' +
+                             string{Usage}};
+    if (!exists(file))
+      throw invalid_argument{"Missing scenario file: "s + file.string()};
+  }
 
 #ifndef NDEBUG
-  cout << "Interactive:" << boolalpha << interactive << endl;
+  // The output in serving / batch mode contains only result frames / records
+  if (!serving && !batch) {
+    cout << "Interactive:" << boolalpha << interactive << endl;
+    cout << "Threads:" << threadsCount << endl;
+    cout << "Algorithm:" << (int)algorithm << endl;
+  }
 #endif  // NDEBUG
 
+  optional<SolutionsCache> cache;
+  if (cacheDir)
+    cache.emplace(*cacheDir);
+
   Config cfg;
+  if (batch) {
+    if (batchFiles.empty())
+      batchFiles = cfg.scenarios();
+    if (!jobsCount)
+      jobsCount = max(thread::hardware_concurrency(), 1U);
+
+    // The records are the only standard output. Any diagnostics written
+    // to cout while exploring the scenarios go to cerr instead
+    ostream records{cout.rdbuf()};
+    cout.rdbuf(cerr.rdbuf());
+    const bool allSolved{solveBatch(batchFiles, records, jobsCount,
+                                    algorithm, threadsCount, maxDfsProbes)};
+    cout.rdbuf(records.rdbuf());
+    return allSolved ? 0 : -1;
+  }
+
+  if (serving) {
+#ifdef _WIN32
+    // The frame sizes count bytes, so no line-ending translations
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif  // _WIN32
+
+    serve(cin, cout, cache ? &*cache : nullptr, algorithm, threadsCount);
+    return 0;
+  }
+
   Scenario scenario{cin, /*solveNow = */ false};
-  const Scenario::Results& sol{
-      scenario.solution(/*usingBFS = */ true, interactive)};
-  if (!sol.attempt->isSolution())
+  if (!solve(scenario, cache ? &*cache : nullptr, algorithm, interactive,
+             threadsCount))
     return -1;
 
   return 0;
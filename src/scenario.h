@@ -15,8 +15,77 @@
 
 #include "scenarioDetails.h"
 
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <optional>
+#include <vector>
+
 namespace rc {
 
+/**
+On-disk cache of the outcomes of explored scenarios, allowing to report again
+a repeated scenario without exploring it one more time.
+
+Each outcome is a file from the cache folder named after the FNV-1a digest of
+its key, which is the same for any platform and build of the solver.
+The key is also stored in the file, so digest collisions are harmless.
+The keys contain FormatVersion, so the outcomes stored in an older format
+are never reported.
+The least recently used outcomes get evicted when there are too many of them.
+
+The cache is only an optimization, so its I/O failures are ignored.
+*/
+class SolutionsCache {
+ public:
+  /// What is needed to report again an explored scenario
+  struct Outcome {
+    /// The results as displayed by their operator<<
+    std::string results;
+
+    /// The JSON array of the moves for the interactive visualization of a
+    /// solution. Empty when there is no solution or they couldn't be prepared
+    std::string moves;
+
+    bool solved{};  ///< was there a solution?
+  };
+
+  /// Default count of outcomes to keep
+  static constexpr size_t DefaultCapacity{1'000ULL};
+
+  /// Version of the stored outcomes, to be increased whenever their content
+  /// or the exploration of the scenarios change
+  /// Version 2: the moves are stored as a JSON string
+  /// Version 3: the keys contain the exact numbers from the scenarios
+  static constexpr unsigned FormatVersion{3U};
+
+  /// Uses (and creates if necessary) the provided folder for the outcomes
+  explicit SolutionsCache(std::filesystem::path dir_,
+                          size_t capacity_ = DefaultCapacity);
+
+  /// @return the outcome stored for the key, if any, marking it as recently
+  /// used
+  [[nodiscard]] std::optional<Outcome> find(const std::string& key) const;
+
+  /// Stores the outcome for the key and evicts the least recently used
+  /// outcomes above the capacity
+  void store(const std::string& key, const Outcome& outcome) const;
+
+  PROTECTED :
+
+      /// The file for the outcome of the key
+      [[nodiscard]] std::filesystem::path
+      fileOf(const std::string& key) const;
+
+  /// Removes the least recently used outcomes above the capacity
+  void evict() const;
+
+  std::filesystem::path dir;  ///< the folder containing the outcomes
+  size_t capacity;            ///< max count of outcomes to keep
+};
+
 /**
 Data and the solution for a river crossing puzzle:
 - entities to move to the opposite bank
@@ -25,6 +94,25 @@ Data and the solution for a river crossing puzzle:
 */
 class Scenario {
  public:
+  /// The supported ways of exploring a scenario
+  enum class Algorithm {
+    BFS,   ///< Breadth-First search - solutions with fewest crossings
+    DFS,   ///< Depth-First search
+    AStar,  ///< A* search - fewest crossings, usually after fewer states than BFS
+
+    /**
+    Uniform-cost search on the elapsed time - solutions taking the least time.
+    Falls back to BFS for the scenarios without crossing durations
+    */
+    UniformCost,
+
+    /**
+    Breadth-First search from both the initial and the target states -
+    fewest crossings. Falls back to BFS when the moves aren't reversible
+    */
+    BidirectionalBFS
+  };
+
   /**
   Results from exploring the scenario.
 
@@ -50,6 +138,10 @@ class Scenario {
 
     /// Count of total investigated states
     size_t investigatedStates{};
+
+    /// Set when the DFS used up its probes budget before finding a solution
+    /// or proving there is none
+    bool interrupted{};
   };
 
  public:
@@ -86,11 +178,75 @@ class Scenario {
   for a Depth-First solution
   @param interactiveSol_ true when an interactive visualization of the solution
   is requested and possible; false by default
+  @param threadsCount how many threads may explore the states; 1 by default.
+  The BFS solution and statistics don't depend on it, unlike the DFS ones
 
   @return the solution or an unsuccessful attempt
   */
   [[nodiscard]] const Results& solution(bool usingBFS = true,
-                                        bool interactiveSol = false);
+                                        bool interactiveSol = false,
+                                        unsigned threadsCount = 1U);
+
+  /**
+  Solves the scenario with the given algorithm if possible.
+  Subsequent calls for the same algorithm use the obtained attempt / solution.
+
+  @param algorithm the algorithm to use
+  @param interactiveSol_ true when an interactive visualization of the solution
+  is requested and possible; false by default
+  @param threadsCount how many threads may explore the states for BFS / DFS;
+  1 by default
+
+  @return the solution or an unsuccessful attempt
+  */
+  [[nodiscard]] const Results& solution(Algorithm algorithm,
+                                        bool interactiveSol = false,
+                                        unsigned threadsCount = 1U);
+
+  /**
+  Explores the scenario with the given algorithm, without displaying anything.
+  Subsequent calls for the same algorithm use the obtained attempt / solution,
+  unless the DFS was interrupted. Then the next call resumes the interrupted
+  DFS with its new `maxDfsProbes` budget, updating the same results
+  @param algorithm the algorithm to use
+  @param threadsCount how many threads may explore the states for BFS / DFS;
+  1 by default
+  @param maxDfsProbes how many raft/bridge configurations the DFS may probe
+  before giving up (see Results::interrupted); unlimited by default.
+  A limited budget makes the DFS sequential, like the resumed DFS-s
+  @return the solution or an unsuccessful attempt
+  */
+  [[nodiscard]] const Results& explore(Algorithm algorithm,
+                                       unsigned threadsCount = 1U,
+                                       size_t maxDfsProbes = SIZE_MAX);
+
+  /**
+  Solves the scenario like solution(algorithm, interactiveSol, threadsCount),
+  unless the cache already knows the outcome of the scenario. The description
+  and the images of the entities don't matter when looking in the cache.
+  Any new outcome gets stored in the cache.
+  @return true if the scenario has a solution
+  */
+  [[nodiscard]] bool cachedSolution(const SolutionsCache& cache,
+                                    Algorithm algorithm,
+                                    bool interactiveSol = false,
+                                    unsigned threadsCount = 1U);
+
+  /**
+  Writes the DFS which `explore` interrupted after spending its probes budget
+  in a form accepted by `loadInterruptedDfs`, even within another process.
+  @return false if there is no interrupted DFS
+  */
+  [[nodiscard]] bool saveInterruptedDfs(std::ostream& os) const;
+
+  /**
+  Replaces the DFS results with the interrupted DFS saved by
+  `saveInterruptedDfs` for the same scenario. The next `explore` with DFS
+  resumes it.
+  @throw domain_error if the saved DFS is invalid or belongs to another
+  scenario
+  */
+  void loadInterruptedDfs(std::istream& is);
 
   [[nodiscard]] std::string toString()
       const;  ///< data apart from the description
@@ -101,6 +257,27 @@ class Scenario {
       void
       outputResults(const Results& res, bool interactiveSol = false) const;
 
+  /// Displays the scenario and the results, as given by their operator<<
+  void outputResultsText(const std::string& results) const;
+
+  /**
+  Writes to os the JSON array of the moves of the solution for its
+  interactive visualization, while walking the solution
+  */
+  void writeInteractiveMoves(std::ostream& os, const Results& res) const;
+
+  /**
+  Displays the interactive visualization of a solution as compact JSON.
+  The moves are provided by writeMoves
+  */
+  void outputInteractive(
+      const std::function<void(std::ostream&)>& writeMoves) const;
+
+  /// @return what identifies the outcome of exploring the scenario in this
+  /// manner within a SolutionsCache
+  [[nodiscard]] std::string cacheKey(Algorithm algorithm,
+                                     unsigned threadsCount) const;
+
   // Read in ctor and reused by outputResults()
   boost::property_tree::ptree entTree;
   boost::property_tree::ptree descrTree;
@@ -111,19 +288,62 @@ class Scenario {
 
   ScenarioDetails details;  ///< relevant details of the scenario
 
-  Results resultsBFS;  ///< the results obtained with Breadth-First search
-  Results resultsDFS;  ///< the results obtained with Depth-First search
+  /// The results obtained by each used algorithm.
+  /// Ensures solving is performed only once with each algorithm, except
+  /// for an interrupted DFS
+  std::map<Algorithm, Results> resultsByAlgorithm;
 
-  /// Ensures solving is performed only once with Breadth-First search
-  bool investigatedByBFS{};
+  /// Keeps the search of a DFS interrupted by its probes budget
+  class InterruptedDfs;
 
-  /// Ensures solving is performed only once with Depth-First search
-  bool investigatedByDFS{};
+  /// The DFS interrupted by its probes budget, which `explore` resumes.
+  /// Like the states from `resultsByAlgorithm`, it refers `details`
+  std::shared_ptr<InterruptedDfs> interruptedDfs;
 
   /// Some scenarios use bridges instead of rafts
   bool bridgeInsteadOfRaft{};
 };
 
+/**
+Solves the scenarios arriving as frames from `in` until its end and writes
+a result frame for each of them to `out`. This allows a web server to keep
+a few solver processes (and their warm caches) for all its requests.
+
+A request frame is a header line with the size in bytes of the scenario
+and optionally the word `interactive`, followed by the scenario itself.
+Blank lines between the frames are ignored.
+
+A result frame is a header line with the exit code a separate launch would
+have returned (0 or -1) and the size in bytes of the output, followed by that
+output (everything the solver wrote to stdout and stderr).
+
+A malformed request header, a too large scenario or a truncated one get
+a result frame with the exit code -1 and the error as output, so the client
+is never left waiting. Serving ends after a truncated scenario or after a
+header without a valid size, as the next frames cannot be found then.
+*/
+void serve(std::istream& in,
+           std::ostream& out,
+           const SolutionsCache* cache,
+           Scenario::Algorithm algorithm,
+           unsigned threadsCount);
+
+/**
+Explores concurrently the scenarios from the provided files, using jobsCount
+threads. Writes to `out` a JSON line with the statistics of each scenario, in
+the order of their completion. The reported peak memory is the one of the
+whole process so far, not just of that scenario.
+A DFS using up its `maxDfsProbes` budget gets reported as interrupted.
+
+@return true if all scenarios were solved
+*/
+[[nodiscard]] bool solveBatch(const std::vector<std::filesystem::path>& files,
+                              std::ostream& out,
+                              unsigned jobsCount,
+                              Scenario::Algorithm algorithm,
+                              unsigned threadsCount,
+                              size_t maxDfsProbes = SIZE_MAX);
+
 }  // namespace rc
 
 namespace std {
@@ -27,6 +27,7 @@
 
 #include <cfloat>
 #include <climits>
+#include <optional>
 
 namespace rc {
 
@@ -76,12 +77,39 @@ class ScenarioDetails {
 
   This is unique_ptr because each raft/bridge configuration might have
   unique features and that state is not the same for all, thus not a shared_ptr
+
+  @param crossingDuration the duration of the first group of the moving
+  entities, when known (see crossingDurationOf)
   */
   [[nodiscard]] std::unique_ptr<ent::IMovingEntitiesExt>
-  createMovingEntitiesExt() const;
+  createMovingEntitiesExt(std::optional<unsigned> crossingDuration = {}) const;
+
+  /**
+  @return the duration from the first CrossingDurationsOfConfigurations item
+  matching the raft/bridge configuration `ents` or nothing if none matches.
+  The capacity and the max load aren't checked, as the solver generates only
+  configurations respecting them
+  */
+  [[nodiscard]] std::optional<unsigned> crossingDurationOf(
+      const ent::IsolatedEntities& ents) const;
+
+  /**
+  Groups the interchangeable entities: those with the same type, weight,
+  starting bank and row-ability, which no constraint mentions individually.
+  Swapping such entities turns any state into an equivalent one.
+  @return the masks of the groups with at least 2 entities. Empty when
+  the entities can't be expressed as masks
+  */
+  [[nodiscard]] std::vector<ent::IdsMask> interchangeableEntities() const;
 
   [[nodiscard]] std::string toString() const;  ///< displays the content
 
+  /**
+  @return the content relevant for the exploration, with all the numbers
+  written exactly, unlike toString(). Different scenarios get different forms
+  */
+  [[nodiscard]] std::string canonicalForm() const;
+
   /// All mentioned entities (at least 3).
   /// shared as several classes keep this information
   std::shared_ptr<const ent::AllEntities> entities;
@@ -125,38 +125,89 @@ unique_ptr<const sol::IState> ScenarioDetails::createInitialState(
       stateExt);
 }
 
-const Scenario::Results& Scenario::solution(bool usingBFS /* = true*/,
-                                            bool interactiveSol /* = false*/) {
-  const Results* results{};
-  if (usingBFS) {
-    if (!investigatedByBFS) {
-      Solver solver{details, resultsBFS};
-      solver.run(usingBFS);
-
-      investigatedByBFS = true;
-    }
+const Scenario::Results& Scenario::solution(
+    bool usingBFS /* = true*/,
+    bool interactiveSol /* = false*/,
+    unsigned threadsCount /* = 1U*/) {
+  return solution(usingBFS ? Algorithm::BFS : Algorithm::DFS, interactiveSol,
+                  threadsCount);
+}
 
-    results = &resultsBFS;
+/// Keeps the Solver of a DFS interrupted by its probes budget
+class Scenario::InterruptedDfs {
+ public:
+  explicit InterruptedDfs(unique_ptr<Solver> solver_) noexcept
+      : solver{std::move(solver_)} {}
 
-  } else {
-    if (!investigatedByDFS) {
-      Solver solver{details, resultsDFS};
-      solver.run(usingBFS);
+  gsl::not_null<unique_ptr<Solver>> solver;  ///< the paused search
+};
 
-      investigatedByDFS = true;
+const Scenario::Results& Scenario::explore(
+    Algorithm algorithm,
+    unsigned threadsCount /* = 1U*/,
+    size_t maxDfsProbes /* = SIZE_MAX*/) {
+  const auto [it, firstUse] = resultsByAlgorithm.try_emplace(algorithm);
+  if (!firstUse && !it->second.interrupted)
+    return it->second;
+
+  try {
+    if (firstUse) {
+      auto solver{
+          make_unique<Solver>(details, it->second, threadsCount, maxDfsProbes)};
+      solver->run(algorithm);
+      if (it->second.interrupted)
+        interruptedDfs = make_shared<InterruptedDfs>(std::move(solver));
+
+    } else {
+      assert(interruptedDfs);
+      interruptedDfs->solver->resumeDfs(maxDfsProbes);
+      if (!it->second.interrupted)
+        interruptedDfs.reset();
     }
+  } catch (...) {
+    resultsByAlgorithm.erase(it);  // allows retrying later
+    interruptedDfs.reset();
+    throw;
+  }
+
+  return it->second;
+}
 
-    results = &resultsDFS;
+bool Scenario::saveInterruptedDfs(ostream& os) const {
+  if (!interruptedDfs)
+    return false;
+
+  interruptedDfs->solver->saveDfs(os);
+  return true;
+}
+
+void Scenario::loadInterruptedDfs(istream& is) {
+  interruptedDfs.reset();
+  Results& results{resultsByAlgorithm[Algorithm::DFS]};
+  results = {};
+  try {
+    auto solver{make_unique<Solver>(details, results)};
+    solver->loadDfs(is);
+    interruptedDfs = make_shared<InterruptedDfs>(std::move(solver));
+  } catch (...) {
+    resultsByAlgorithm.erase(Algorithm::DFS);
+    throw;
   }
+}
+
+const Scenario::Results& Scenario::solution(
+    Algorithm algorithm,
+    bool interactiveSol /* = false*/,
+    unsigned threadsCount /* = 1U*/) {
+  const Results& results{explore(algorithm, threadsCount)};
 
   try {
-    const gsl::not_null<const Results*> safeResults{results};
-    outputResults(*safeResults, interactiveSol);
+    outputResults(results, interactiveSol);
   } catch (const exception&) {
     cerr << "Unable to prepare the solution animation!" << endl;
   }
 
-  return *results;
+  return results;
 }
 
 }  // namespace rc
@@ -13,22 +13,48 @@
 #ifndef HPP_SOLVER_DETAIL
 #define HPP_SOLVER_DETAIL
 
+#include "durationExt.h"
+#include "mathRelated.h"
 #include "rowAbilityExt.h"
 #include "scenario.h"
+#include "transferredLoadExt.h"
 #include "util.h"
 
 #include <cstddef>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <climits>
 #include <concepts>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
 #include <iterator>
+#include <mutex>
+#include <optional>
 #include <queue>
+#include <ranges>
+#include <string_view>
+#include <thread>
 #include <tuple>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 using std::ignore;
 
 namespace {
 
+/// The slot of `CrossingIndex` within the Symbols Tables
+constexpr unsigned CrossingIndexSlot{rc::SymbolsTable::CrossingIndexSlot};
+
+/// The slot of `PreviousRaftLoad` within the Symbols Tables
+constexpr unsigned PreviousRaftLoadSlot{
+    rc::SymbolsTable::PreviousRaftLoadSlot};
+
 /**
 Generates all k-combinations of the elements within first .. end.
 If the iterators come from `std::unordered_...`,
@@ -80,14 +106,42 @@ void generateCombinations(const BidirIt first,
   }
 }
 
-/// Raft/bridge configuration plus the associated validator
+/// @return the provided loads sorted increasingly, merging those closer than
+/// rc::Eps
+std::vector<double> distinctLoads(std::vector<double> loads) {
+  std::ranges::sort(loads);
+  const auto [newEnd, oldEnd] = std::ranges::unique(
+      loads, [](double a, double b) { return b - a < rc::Eps; });
+  loads.erase(newEnd, oldEnd);
+  return loads;
+}
+
+/// @return the index of `load` within the `distinctLoads` or nothing if it's
+/// missing
+std::optional<unsigned> loadIdIn(const std::vector<double>& distinctLoads,
+                                 double load) noexcept {
+  const auto it = std::ranges::lower_bound(distinctLoads, load - rc::Eps);
+  if (it == std::cend(distinctLoads) || *it > load + rc::Eps)
+    return {};
+  return (unsigned)std::distance(std::cbegin(distinctLoads), it);
+}
+
+/**
+Raft/bridge configuration plus the associated validator.
+The configuration is an immutable flyweight shared by all the moves using it
+*/
 class MovingConfigOption {
  public:
+  /// `idx_` is the index of the option among all the configurations
   explicit MovingConfigOption(
       const rc::ent::MovingEntities& cfg_,
       const std::shared_ptr<const rc::cond::IContextValidator>& validator_ =
-          rc::cond::DefContextValidator::SHARED_INST()) noexcept
-      : cfg{cfg_}, validator{validator_} {}
+          rc::cond::DefContextValidator::SHARED_INST(),
+      unsigned idx_ = 0U)
+      : cfg{std::make_shared<const rc::ent::MovingEntities>(cfg_)},
+        cfgMask{cfg_.idsMask()},
+        validator{validator_},
+        idx{idx_} {}
   MovingConfigOption(const MovingConfigOption&) noexcept = default;
   ~MovingConfigOption() noexcept = default;
 
@@ -108,7 +162,21 @@ class MovingConfigOption {
                               const rc::SymbolsTable& SymTb) const {
     using namespace std;
 
-    const set<unsigned>&raftIds{cfg.ids()}, &bankIds{bank.ids()};
+    if (cfgMask) {
+      if (const optional<rc::ent::IdsMask> bankMask{bank.idsMask()};
+          bankMask) {
+        if (*cfgMask & ~*bankMask) {
+#ifndef NDEBUG
+          cout << "Invalid ids: "
+               << rc::ContView{cfg->ids(), {"", " ", "\n"}};
+#endif                   // NDEBUG
+          return false;  // cfg should not contain id-s outside bank
+        }
+        return validator->validate(*cfg, SymTb);
+      }
+    }
+
+    const set<unsigned>&raftIds{cfg->ids()}, &bankIds{bank.ids()};
     for (const unsigned id : raftIds)
       if (!bankIds.contains(id)) {
 #ifndef NDEBUG
@@ -117,21 +185,41 @@ class MovingConfigOption {
 #endif                 // NDEBUG
         return false;  // cfg should not contain id-s outside bank
       }
-    return validator->validate(cfg, SymTb);
+    return validator->validate(*cfg, SymTb);
   }
 
   /// @return the contained raft/bridge configuration
   [[nodiscard]] const rc::ent::MovingEntities& get() const noexcept {
+    return *cfg;
+  }
+
+  /// @return the shared contained raft/bridge configuration
+  [[nodiscard]] const std::shared_ptr<const rc::ent::MovingEntities>& shared()
+      const noexcept {
     return cfg;
   }
 
+  /// @return the ids of the configuration as bits, when masks are allowed
+  [[nodiscard]] const std::optional<rc::ent::IdsMask>& mask() const noexcept {
+    return cfgMask;
+  }
+
+  /// @return the index of the option among all the configurations
+  [[nodiscard]] unsigned index() const noexcept { return idx; }
+
   PROTECTED :
 
       /// Raft/bridge configuration
-      const rc::ent::MovingEntities cfg;
+      const std::shared_ptr<const rc::ent::MovingEntities>
+          cfg;
+
+  /// The ids of cfg as bits, computed once. Empty when masks aren't allowed
+  const std::optional<rc::ent::IdsMask> cfgMask;
 
   /// The associated validator
   gsl::not_null<std::shared_ptr<const rc::cond::IContextValidator>> validator;
+
+  unsigned idx;  ///< the index of the option among all the configurations
 };
 
 /**
@@ -189,10 +277,42 @@ class MovingConfigsManager {
           " - expecting scenario details with a raft/bridge capacity "
           "less than the number of mentioned entities!"s};
 
+    // When the entities which row only sometimes do this periodically based
+    // on CrossingIndex, their row-ability gets tabulated per residue and
+    // the CanRowValidator becomes unnecessary
+    optional<unsigned> period;
+    if (!rowSometimesIds.empty()) {
+      period = 1U;
+      for (const unsigned id : rowSometimesIds) {
+        const size_t tableSize{
+            size((*entities)[id]->canRowByCrossingIndex())};
+        if (!tableSize) {
+          period.reset();
+          break;
+        }
+        if (period = commonPeriod(period, (unsigned)tableSize); !period)
+          break;
+      }
+    }
+
+    // The allowed loads depending at most on PreviousRaftLoad get tabulated
+    // below, so the AllowedLoadsValidator from the transfer validator becomes
+    // unnecessary
+    if (const shared_ptr<const IValues<double>>& allowedLoads{
+            scenarioDetails->allowedLoads}) {
+      allowedLoadsProgram = ExprProgram::compileContains(*allowedLoads);
+      if (allowedLoadsProgram &&
+          !allowedLoadsProgram->readsOnlyVariable(PreviousRaftLoadSlot))
+        allowedLoadsProgram.reset();
+    }
+
     shared_ptr<const IContextValidator> validatorWithoutCanRow{
-        scenarioDetails_.createTransferValidator()},
+        allowedLoadsProgram ? DefContextValidator::SHARED_INST()
+                            : scenarioDetails_.createTransferValidator()},
         validatorWithCanRow{
-            make_shared<const CanRowValidator>(validatorWithoutCanRow)};
+            period ? validatorWithoutCanRow
+                   : make_shared<const CanRowValidator>(
+                         validatorWithoutCanRow)};
 
 #ifndef NDEBUG
     cout << "All possible raft configs: \n";
@@ -229,6 +349,14 @@ class MovingConfigsManager {
 #ifndef NDEBUG
     cout << endl;
 #endif  // NDEBUG
+
+    groupConfigsByResidue(period);
+
+    if (!scenarioDetails->ctdItems.empty())
+      checkCrossingDurations();
+
+    if (allowedLoadsProgram)
+      tabulateAllowedLoads();
   }
   MovingConfigsManager(const MovingConfigsManager&) noexcept = default;
   ~MovingConfigsManager() noexcept = default;
@@ -247,39 +375,100 @@ class MovingConfigsManager {
   This heuristic should let the algorithm find a solution quicker.
 
   @param bank the bank configuration from which to select the raft candidates
-  @param result the possible raft configurations
+  @param result the possible raft configurations, which provide directly
+  their shared flyweights and their indices within `configs()`
   @param largerConfigsFirst how to order the results. Larger to smaller or the
   other way around
   */
   void configsForBank(const rc::ent::BankEntities& bank,
-                      std::vector<const rc::ent::MovingEntities*>& result,
+                      std::vector<const MovingConfigOption*>& result,
                       bool largerConfigsFirst) const {
+    configsForBank(bank, result, largerConfigsFirst, *SymTb);
+  }
+
+  /**
+  Same as the overload above, except the dynamic validations use the provided
+  `st` Symbols Table instead of the one of the manager.
+  Allows several threads to query the configurations concurrently, each with
+  its own Symbols Table.
+  */
+  void configsForBank(const rc::ent::BankEntities& bank,
+                      std::vector<const MovingConfigOption*>& result,
+                      bool largerConfigsFirst,
+                      const rc::SymbolsTable& st) const {
     using namespace std;
 
 #ifndef NDEBUG
     cout << "\nInvalid raft configs:\n";
 #endif  // NDEBUG
     result.clear();
-    if (largerConfigsFirst) {
-      const auto itEnd = crend(allConfigs);
-      for (auto it = crbegin(allConfigs); it != itEnd; ++it) {
-        const MovingConfigOption& cfgOption{*it};
-        if (cfgOption.validFor(bank, *SymTb))
-          result.push_back(&cfgOption.get());
-      }
+    const size_t residue{residueOf(st)};
+    const vector<bool>* const admissibleLoads_{admissibleLoadsFor(st)};
+    const auto checkCandidate = [&](unsigned idx) {
+      if (admissibleLoads_ && !(*admissibleLoads_)[loadIdOfConfig[idx]])
+        return;
+      const MovingConfigOption& cfgOption{allConfigs[idx]};
+      if (cfgOption.validFor(bank, st))
+        result.push_back(&cfgOption);
+    };
+    if (const optional<rc::ent::IdsMask> bankMask{bank.idsMask()};
+        bankMask && !subsetTries.empty()) {
+      // Visiting only the configurations included in the bank, in the order
+      // from allConfigs
+      thread_local vector<unsigned> candidates;
+      subsetsOf(subsetTries[residue], *bankMask, candidates);
+      ranges::sort(candidates);
+      if (largerConfigsFirst)
+        ranges::for_each(candidates | views::reverse, checkCandidate);
+      else
+        ranges::for_each(candidates, checkCandidate);
+
+    } else if (largerConfigsFirst) {
+      ranges::for_each(configsByResidue[residue] | views::reverse,
+                       checkCandidate);
     } else {
-      for (const MovingConfigOption& cfgOption : allConfigs)
-        if (cfgOption.validFor(bank, *SymTb))
-          result.push_back(&cfgOption.get());
+      ranges::for_each(configsByResidue[residue], checkCandidate);
     }
 #ifndef NDEBUG
     cout << "\nValid raft configs:\n";
-    for (const rc::ent::MovingEntities* me : result)
-      cout << *me << '\n';
+    for (const MovingConfigOption* cfgOption : result)
+      cout << cfgOption->get() << '\n';
     cout << endl;
 #endif  // NDEBUG
   }
 
+  /**
+  @return the minimum and maximum number of entities from the possible
+  raft/bridge configurations or (0, 0) if there are no such configurations.
+  Since every configuration contains some entity able to row, the range
+  starts from at least 1
+  */
+  [[nodiscard]] std::pair<size_t, size_t> configsSizesRange() const noexcept {
+    if (allConfigs.empty())
+      return {};
+
+    // allConfigs is sorted increasingly by the size of the configurations
+    return {allConfigs.front().get().count(), allConfigs.back().get().count()};
+  }
+
+  /// @return all possible raft/bridge configurations
+  [[nodiscard]] const std::vector<MovingConfigOption>& configs()
+      const noexcept {
+    return allConfigs;
+  }
+
+  /**
+  @return the shared flyweight of `cfg`, which must be one of the configurations
+  provided by `configsForBank`.
+  Meant only for rebuilding the moves of a solution from the nodes of a search,
+  as the searches get the flyweights directly from `configsForBank`
+  @throw out_of_range for other configurations
+  */
+  [[nodiscard]] const std::shared_ptr<const rc::ent::MovingEntities>&
+  sharedConfig(const rc::ent::MovingEntities& cfg) const {
+    return allConfigs[idxOfConfig.at(&cfg)].shared();
+  }
+
   PROTECTED :
 
       /**
@@ -300,13 +489,269 @@ class MovingConfigsManager {
 
     assert(scenarioDetails->transferConstraints);
     if (scenarioDetails->transferConstraints->check(me)) {
-      allConfigs.emplace_back(me, validator);
+      // Resolves here the crossing duration, once per configuration
+      if (!scenarioDetails->ctdItems.empty())
+        me = MovingEntities{entities, cfg,
+                            scenarioDetails->createMovingEntitiesExt(
+                                scenarioDetails->crossingDurationOf(me))};
+      const unsigned idx{(unsigned)size(allConfigs)};
+      allConfigs.emplace_back(me, validator, idx);
+      idxOfConfig.emplace(&allConfigs.back().get(), idx);
 #ifndef NDEBUG
       cout << rc::ContView{cfg, {"", " ", "\n"}};
 #endif  // NDEBUG
     }
   }
 
+  /// Node of a trie indexing configurations from allConfigs by their masks
+  struct SubsetTrieNode {
+    static constexpr unsigned None{UINT_MAX};  ///< no child / sibling / config
+
+    unsigned bit{};                ///< the bit appended to the parent path
+    unsigned firstChild{None};     ///< the first child node
+    unsigned nextSibling{None};    ///< the next sibling node
+    unsigned configIdx{None};      ///< the config ending here, if any
+  };
+
+  /**
+  Groups the indices of allConfigs by the residues of `CrossingIndex` modulo
+  `period`, keeping only the configurations having some entity able to row
+  for each residue. An extra group covers the Symbols Tables without
+  `CrossingIndex` and keeps only the configurations with entities which
+  always row. Without a `period`, there is a single group with all
+  the configurations.
+  Indexes then each group within a subset trie, when masks are allowed.
+  */
+  void groupConfigsByResidue(const std::optional<unsigned>& period) {
+    using namespace std;
+
+    const rc::ent::AllEntities& entities{*scenarioDetails->entities};
+    const unsigned configsCount{(unsigned)size(allConfigs)};
+    crossingIndexPeriod = period.value_or(0U);
+    const unsigned groupsCount{crossingIndexPeriod + 1U};
+    configsByResidue.assign(groupsCount, {});
+    for (unsigned residue{}; residue < groupsCount; ++residue) {
+      const auto rowsNow = [&](unsigned id) {
+        const rc::ent::IEntity& ent{*entities[id]};
+        const boost::logic::tribool canRow{ent.canRow()};
+        if (!boost::logic::indeterminate(canRow))
+          return (bool)canRow;
+        if (!period)
+          return true;  // left for the CanRowValidator
+        if (residue == crossingIndexPeriod)
+          return false;  // unknown CrossingIndex
+        const vector<bool>& table{ent.canRowByCrossingIndex()};
+        return (bool)table[residue % size(table)];
+      };
+      vector<unsigned>& configs{configsByResidue[residue]};
+      for (unsigned idx{}; idx < configsCount; ++idx)
+        if (ranges::any_of(allConfigs[idx].get().ids(), rowsNow))
+          configs.push_back(idx);
+    }
+
+    subsetTries.clear();
+    if (entities.masksAllowed())
+      for (const vector<unsigned>& configs : configsByResidue)
+        subsetTries.push_back(buildSubsetTrie(configs));
+  }
+
+  /**
+  Ensures the configurations from allConfigs know their crossing duration
+  (see CrossingDurationExt), so the solver never needs to search it.
+  @throw domain_error listing the configurations not covered by any
+  CrossingDurationsOfConfigurations item
+  */
+  void checkCrossingDurations() const {
+    using namespace std;
+
+    ostringstream uncovered;
+    for (const MovingConfigOption& cfgOption : allConfigs) {
+      const rc::ent::CrossingDurationExt* const durationExt{
+          rc::ent::AbsMovingEntitiesExt::selectExt<
+              rc::ent::CrossingDurationExt>(cfgOption.get().getExtension())};
+      if (!durationExt || !durationExt->crossingDuration())
+        uncovered << "\n\t" << cfgOption.get();
+    }
+
+    if (const string uncoveredConfigs{uncovered.str()};
+        !uncoveredConfigs.empty())
+      throw domain_error{
+          HERE.function_name() +
+          " - Provided CrossingDurationsOfConfigurations items don't cover "
+          "these raft configurations:"s +
+          uncoveredConfigs};
+  }
+
+  /**
+  Gathers the distinct loads of the configurations from allConfigs and
+  evaluates the allowed loads for each pair (previous load, load).
+  The rows whose evaluation fails are left empty and get evaluated
+  within `admissibleLoadsFor`, which will report the failure.
+  */
+  void tabulateAllowedLoads() {
+    using namespace std;
+
+    assert(allowedLoadsProgram);
+    vector<double> configLoads;
+    configLoads.reserve(size(allConfigs));
+    for (const MovingConfigOption& cfgOption : allConfigs) {
+      const gsl::not_null<const rc::ent::TotalLoadExt*> totalLoadExt{
+          rc::ent::AbsMovingEntitiesExt::selectExt<rc::ent::TotalLoadExt>(
+              cfgOption.get().getExtension())};
+      configLoads.push_back(totalLoadExt->totalLoad());
+    }
+
+    loads = distinctLoads(configLoads);
+
+    loadIdOfConfig.clear();
+    loadIdOfConfig.reserve(size(configLoads));
+    for (const double load : configLoads)
+      loadIdOfConfig.push_back(*loadIdOf(load));
+
+    const size_t loadsCount{size(loads)};
+    const auto admissibleAfter = [&](const rc::SymbolsTable& st) {
+      vector<bool> row(loadsCount);
+      try {
+        for (size_t loadId{}; loadId < loadsCount; ++loadId)
+          row[loadId] = allowedLoadsProgram->run(st, loads[loadId]) != 0.;
+      } catch (...) {
+        row.clear();
+      }
+      return row;
+    };
+
+    loadsDependOnPrevLoad =
+        scenarioDetails->allowedLoads->dependsOnVariable("PreviousRaftLoad");
+    admissibleLoads.clear();
+    if (!loadsDependOnPrevLoad) {
+      admissibleLoads.push_back(admissibleAfter(rc::SymbolsTable{}));
+      return;
+    }
+
+    rc::SymbolsTable st;
+    for (const double prevLoad : loads) {
+      st[PreviousRaftLoadSlot] = prevLoad;
+      admissibleLoads.push_back(admissibleAfter(st));
+    }
+
+    // Initially there is no previous load and all loads are allowed
+    // (see InitiallyNoPrevRaftLoadExcHandler)
+    admissibleLoads.emplace_back(loadsCount, true);
+  }
+
+  /// @return the index within `loads` of `load` or nothing if it's missing
+  [[nodiscard]] std::optional<unsigned> loadIdOf(double load) const noexcept {
+    return loadIdIn(loads, load);
+  }
+
+  /**
+  @return the admissible loads (indexed like `loads`) for the context `st`
+  or NULL when the allowed loads aren't tabulated
+  @throw out_of_range when `PreviousRaftLoad` is missing from `st` outside
+  the initial state
+  @throw the exceptions from the evaluation of the allowed loads
+  */
+  [[nodiscard]] const std::vector<bool>* admissibleLoadsFor(
+      const rc::SymbolsTable& st) const {
+    using namespace std;
+
+    if (!allowedLoadsProgram)
+      return nullptr;
+
+    if (!loadsDependOnPrevLoad) {
+      if (!admissibleLoads.front().empty())
+        return &admissibleLoads.front();
+    } else if (!st.contains(PreviousRaftLoadSlot)) {
+      const bool isInitialState{st.contains(CrossingIndexSlot) &&
+                                st.at(CrossingIndexSlot) <= 1. + rc::Eps};
+      if (!isInitialState)
+        throw out_of_range{HERE.function_name() +
+                           " - Missing PreviousRaftLoad!"s};
+      return &admissibleLoads.back();
+
+    } else if (const optional<unsigned> prevLoadId{
+                   loadIdOf(st.at(PreviousRaftLoadSlot))};
+               prevLoadId && !admissibleLoads[*prevLoadId].empty()) {
+      return &admissibleLoads[*prevLoadId];
+    }
+
+    // Unexpected previous load or failed tabulation
+    thread_local vector<bool> row;
+    const size_t loadsCount{size(loads)};
+    row.resize(loadsCount);
+    for (size_t loadId{}; loadId < loadsCount; ++loadId)
+      row[loadId] = allowedLoadsProgram->run(st, loads[loadId]) != 0.;
+    return &row;
+  }
+
+  /// @return the index of the group from configsByResidue to use for `st`
+  [[nodiscard]] size_t residueOf(const rc::SymbolsTable& st) const {
+    if (!crossingIndexPeriod)
+      return 0ULL;
+    if (!st.contains(CrossingIndexSlot))
+      return crossingIndexPeriod;
+    return (size_t)std::lround(st.at(CrossingIndexSlot)) % crossingIndexPeriod;
+  }
+
+  /**
+  Indexes the configurations from allConfigs with the provided indices within
+  a trie whose paths follow the increasing bits of the masks of
+  the configurations.
+  Only the subtrees rooted at bits present in a given bank need to be visited
+  to find the configurations included in that bank.
+  */
+  [[nodiscard]] std::vector<SubsetTrieNode> buildSubsetTrie(
+      const std::vector<unsigned>& configIndices) const {
+    std::vector<SubsetTrieNode> subsetTrie(1ULL);  // the root
+    for (const unsigned idx : configIndices) {
+      const std::optional<rc::ent::IdsMask>& cfgMask{allConfigs[idx].mask()};
+      assert(cfgMask);
+      unsigned node{};
+      for (rc::ent::IdsMask rest{*cfgMask}; rest; rest &= rest - 1ULL) {
+        const unsigned bit{(unsigned)std::countr_zero(rest)};
+        unsigned child{subsetTrie[node].firstChild};
+        while (child != SubsetTrieNode::None && subsetTrie[child].bit != bit)
+          child = subsetTrie[child].nextSibling;
+        if (child == SubsetTrieNode::None) {
+          child = (unsigned)size(subsetTrie);
+          subsetTrie.push_back(
+              {.bit = bit, .nextSibling = subsetTrie[node].firstChild});
+          subsetTrie[node].firstChild = child;
+        }
+        node = child;
+      }
+      subsetTrie[node].configIdx = idx;
+    }
+    return subsetTrie;
+  }
+
+  /**
+  Collects within `result` the indices from allConfigs of the configurations
+  from `subsetTrie` included in `bankMask`, in no particular order.
+  The visited trie nodes are only prefixes of such configurations.
+  */
+  static void subsetsOf(const std::vector<SubsetTrieNode>& subsetTrie,
+                        rc::ent::IdsMask bankMask,
+                        std::vector<unsigned>& result) {
+    result.clear();
+    thread_local std::vector<unsigned> pending;
+    pending.assign(1ULL, 0U);  // the root
+    while (!pending.empty()) {
+      const unsigned node{pending.back()};
+      pending.pop_back();
+      for (unsigned child{subsetTrie[node].firstChild};
+           child != SubsetTrieNode::None;
+           child = subsetTrie[child].nextSibling) {
+        const SubsetTrieNode& childNode{subsetTrie[child]};
+        if (!(bankMask & (rc::ent::IdsMask{1ULL} << childNode.bit)))
+          continue;
+        if (childNode.configIdx != SubsetTrieNode::None)
+          result.push_back(childNode.configIdx);
+        pending.push_back(child);
+      }
+    }
+  }
+
   /// The details of the scenario
   gsl::not_null<const rc::ScenarioDetails*> scenarioDetails;
 
@@ -315,6 +760,103 @@ class MovingConfigsManager {
   /// All possible raft/bridge configurations considering all entities are on
   /// the same bank
   std::vector<MovingConfigOption> allConfigs;
+
+  /// The index within allConfigs of each configuration
+  std::unordered_map<const rc::ent::MovingEntities*, unsigned> idxOfConfig;
+
+  /**
+  Indices of the configurations from allConfigs with some entity able to row
+  for each residue of `CrossingIndex` modulo crossingIndexPeriod
+  (see groupConfigsByResidue)
+  */
+  std::vector<std::vector<unsigned>> configsByResidue;
+
+  /// The period of the tabulated row-abilities or 0 when they aren't tabulated
+  unsigned crossingIndexPeriod{};
+
+  /**
+  The compiled allowed loads when they depend at most on `PreviousRaftLoad`,
+  which allows tabulating them. Otherwise they are checked by the validators
+  of the configurations
+  */
+  std::optional<rc::cond::ExprProgram> allowedLoadsProgram;
+
+  /// Distinct loads of the configurations from allConfigs in increasing order
+  std::vector<double> loads;
+
+  /// The index within `loads` of the load of each configuration
+  std::vector<unsigned> loadIdOfConfig;
+
+  /**
+  The admissible loads after each load from `loads`, followed by those from
+  the initial state. A single row when the allowed loads don't depend on
+  `PreviousRaftLoad`
+  */
+  std::vector<std::vector<bool>> admissibleLoads;
+
+  /// Do the allowed loads depend on `PreviousRaftLoad`?
+  bool loadsDependOnPrevLoad{};
+
+  /// Subset indices of configsByResidue. Empty when masks aren't allowed
+  std::vector<std::vector<SubsetTrieNode>> subsetTries;
+};
+
+/**
+The groups of interchangeable entities (see
+`ScenarioDetails::interchangeableEntities`).
+States differing only by swapping such entities are equivalent, so the search
+needs to examine just one state from each such class, which has the same count
+of entities from every group on each bank.
+*/
+class InterchangeableEntities {
+ public:
+  InterchangeableEntities() noexcept = default;
+  explicit InterchangeableEntities(std::vector<rc::ent::IdsMask> groups_)
+      : groups{std::move(groups_)} {}
+
+  /// @return true if there are no interchangeable entities
+  [[nodiscard]] bool empty() const noexcept { return groups.empty(); }
+
+  /**
+  @return the representative of the sets of entities obtained from `mask` by
+  swapping interchangeable entities: from every group it takes the lowest
+  bits, as many as `mask` has from that group
+  */
+  [[nodiscard]] rc::ent::IdsMask canonical(
+      rc::ent::IdsMask mask) const noexcept {
+    for (const rc::ent::IdsMask group : groups) {
+      int count{std::popcount(mask & group)};
+      mask &= ~group;
+      for (rc::ent::IdsMask rest{group}; count > 0; --count) {
+        mask |= rest & (~rest + 1ULL);  // lowest bit of rest
+        rest &= rest - 1ULL;
+      }
+    }
+    return mask;
+  }
+
+  /**
+  Keeps only the first configuration from each class of equivalent
+  raft/bridge configurations. Configurations taking the same count of
+  entities from every group out of the same bank produce equivalent states
+  */
+  void dropEquivalentConfigs(
+      std::vector<const MovingConfigOption*>& configs) const {
+    if (groups.empty())
+      return;
+
+    thread_local std::unordered_set<rc::ent::IdsMask> kept;
+    kept.clear();
+    std::erase_if(configs, [this](const MovingConfigOption* cfgOption) {
+      return !kept.insert(canonical(*cfgOption->mask())).second;
+    });
+  }
+
+  PROTECTED :
+
+      /// The masks of the groups of interchangeable entities
+      std::vector<rc::ent::IdsMask>
+          groups;
 };
 
 /// A state during solving the scenario
@@ -468,7 +1010,227 @@ class State : public rc::sol::IState {
   bool _nextMoveFromLeft;
 };
 
-/// The moved entities and the resulted state
+/**
+The examined states indexed by what `State::handledBy` compares anyway:
+the direction of the next move and the less crowded bank.
+Each bucket holds only mutually independent states sharing such a key,
+so checking / adding a state inspects just the candidates from its bucket,
+instead of all the examined states.
+*/
+class ExaminedStates {
+ public:
+  ExaminedStates() noexcept = default;
+
+  /// Considers equivalent the states differing by interchangeable entities
+  explicit ExaminedStates(
+      const InterchangeableEntities& interchangeable_) noexcept
+      : interchangeable{interchangeable_.empty() ? nullptr
+                                                 : &interchangeable_} {}
+  ~ExaminedStates() noexcept = default;
+
+  ExaminedStates(const ExaminedStates&) = delete;
+  ExaminedStates(ExaminedStates&&) = delete;
+  void operator=(const ExaminedStates&) = delete;
+  void operator=(ExaminedStates&&) = delete;
+
+  /// @return true if the examined states cover already the state `s`
+  [[nodiscard]] bool cover(const rc::sol::IState& s) const {
+    const auto it = buckets.find(keyOf(s));
+    if (it == cend(buckets))
+      return false;
+
+    for (const auto& prevSt : it->second)
+      if (handledBy(s, *prevSt)) {
+#ifndef NDEBUG
+        std::cout << "previously considered state" << std::endl;
+#endif  // NDEBUG
+        return true;
+      }
+
+    return false;
+  }
+
+  /**
+  Adds `s`, which should be a newer / better state than the examined ones.
+  The previous states from its bucket which are inferior to `s` get removed.
+  The states are immutable, so `s` can be shared with the moves or the nodes
+  of the search, instead of keeping a copy of it.
+  */
+  void add(std::shared_ptr<const rc::sol::IState> s) {
+    auto& bucket = buckets[keyOf(*s)];
+    const auto removed{std::erase_if(bucket, [this, &s](const auto& prevSt) {
+      return handledBy(*prevSt, *s);
+    })};
+    bucket.push_back(std::move(s));
+    statesCount = statesCount + 1ULL - removed;
+  }
+
+  /// @return the count of the kept examined states
+  [[nodiscard]] size_t size() const noexcept { return statesCount; }
+
+  /**
+  @return the hash of the direction of the next move and of the less
+  crowded bank of `s` (plus which bank was that).
+  With interchangeable entities, it's the hash of the direction and of
+  the canonical left bank.
+  Only the states with the same key can handle each other
+  */
+  [[nodiscard]] size_t keyOf(const rc::sol::IState& s) const noexcept {
+    if (interchangeable)
+      return (s.nextMoveFromLeft() ? 1ULL : 0ULL) ^
+             std::hash<rc::ent::IdsMask>{}(
+                 interchangeable->canonical(*s.leftBank().idsMask()) << 1);
+
+    const rc::ent::BankEntities &left{s.leftBank()}, &right{s.rightBank()};
+    const bool leftIsLessCrowded{left.count() <= right.count()};
+    const rc::ent::BankEntities& lessCrowded{leftIsLessCrowded ? left : right};
+    size_t result{(s.nextMoveFromLeft() ? 1ULL : 0ULL) |
+                  (leftIsLessCrowded ? 2ULL : 0ULL)};
+    if (const auto mask{lessCrowded.idsMask()})
+      return result ^ std::hash<rc::ent::IdsMask>{}(*mask << 2);
+
+    for (const unsigned id : lessCrowded.ids())
+      result ^= std::hash<unsigned>{}(id) + 0x9e3779b97f4a7c15ULL +
+                (result << 6) + (result >> 2);
+    return result;
+  }
+
+#ifndef NDEBUG
+  /**
+  Testing duplicate/redundancy among the examined states.
+  States with different keys can't handle each other, so only the states
+  within each bucket need to be compared.
+  */
+  void checkNoRedundancy() const {
+    using namespace std;
+
+    for (const auto& [key, bucket] : buckets) {
+      const auto lim{bucket.size()};
+      for (auto i{0ULL}; i < lim; ++i) {
+        const auto& oneState = bucket[i];
+        for (auto j{i + 1ULL}; j < lim; ++j) {
+          const auto& otherState = bucket[j];
+          if (handledBy(*otherState, *oneState) ||
+              handledBy(*oneState, *otherState)) {
+            cout << "Found duplicate/redundancy among the examined states:\n"
+                 << *oneState << '\n'
+                 << *otherState << endl;
+            assert(false);
+          }
+        }
+      }
+    }
+  }
+#endif  // NDEBUG
+
+  PROTECTED :
+
+      /**
+      @return true if `other` is the same or a better version of `s`, like
+      `State::handledBy`, or of a state equivalent to `s`
+      */
+      [[nodiscard]] bool
+      handledBy(const rc::sol::IState& s,
+                const rc::sol::IState& other) const {
+    if (!interchangeable)
+      return s.handledBy(other);
+
+    return s.getExtension()->isNotBetterThan(other) &&
+           s.nextMoveFromLeft() == other.nextMoveFromLeft() &&
+           interchangeable->canonical(*s.leftBank().idsMask()) ==
+               interchangeable->canonical(*other.leftBank().idsMask());
+  }
+
+  /// The examined states grouped by their key
+  std::unordered_map<size_t,
+                     std::vector<std::shared_ptr<const rc::sol::IState>>>
+      buckets;
+
+  /// The interchangeable entities, if any
+  const InterchangeableEntities* interchangeable{};
+
+  size_t statesCount{};  ///< count of the kept examined states
+};
+
+/**
+Examined states shared by several threads. They are split in stripes, each
+with its own lock, so the threads rarely wait for each other.
+A state can be handled only by states with the same key (see
+`ExaminedStates::keyOf`), so the stripe of each state is chosen by its key.
+*/
+class StripedExaminedStates {
+ public:
+  /// Count of the stripes, each with its own lock
+  static constexpr size_t StripesCount{64ULL};
+
+  explicit StripedExaminedStates(
+      const InterchangeableEntities& interchangeable) {
+    stripes.reserve(StripesCount);
+    for (size_t i{}; i < StripesCount; ++i)
+      stripes.push_back(std::make_unique<Stripe>(interchangeable));
+  }
+  ~StripedExaminedStates() noexcept = default;
+
+  StripedExaminedStates(const StripedExaminedStates&) = delete;
+  StripedExaminedStates(StripedExaminedStates&&) = delete;
+  void operator=(const StripedExaminedStates&) = delete;
+  void operator=(StripedExaminedStates&&) = delete;
+
+  /**
+  Adds `s` unless the examined states cover it already.
+  The check and the addition happen under the lock of the stripe of `s`.
+  @return true if `s` was added
+  */
+  [[nodiscard]] bool addIfNotCovered(
+      const std::shared_ptr<const rc::sol::IState>& s) {
+    Stripe& stripe{*stripes[stripeOf(*s)]};
+    const std::lock_guard lock{stripe.mtx};
+    if (stripe.states.cover(*s))
+      return false;
+
+    stripe.states.add(s);
+    return true;
+  }
+
+  /// @return the count of the kept examined states
+  [[nodiscard]] size_t size() const {
+    size_t result{};
+    for (const std::unique_ptr<Stripe>& stripe : stripes) {
+      const std::lock_guard lock{stripe->mtx};
+      result += stripe->states.size();
+    }
+    return result;
+  }
+
+  PROTECTED :
+
+      /// A part of the examined states, with its lock
+      struct Stripe {
+    explicit Stripe(const InterchangeableEntities& interchangeable)
+        : states{interchangeable} {}
+
+    std::mutex mtx;         ///< guards `states`
+    ExaminedStates states;  ///< the examined states from this stripe
+  };
+
+  /// @return the index of the stripe for the state `s`
+  [[nodiscard]] size_t stripeOf(const rc::sol::IState& s) const noexcept {
+    // Multiplicative hashing, since std::hash might be the identity for
+    // the masks, whose keys would then differ only in a few bits
+    static_assert(std::has_single_bit(StripesCount));
+    return size_t(
+        (stripes.front()->states.keyOf(s) * 0x9e3779b97f4a7c15ULL) >>
+        (64 - std::countr_zero(StripesCount)));
+  }
+
+  std::vector<std::unique_ptr<Stripe>> stripes;  ///< the stripes
+};
+
+/**
+The moved entities and the resulted state.
+The moved entities are usually the flyweights of the raft/bridge
+configurations from MovingConfigsManager, which the moves only share
+*/
 class Move : public rc::sol::IMove {
  public:
   /*
@@ -476,7 +1238,15 @@ class Move : public rc::sol::IMove {
   WARN_MSVC_BRACED_INIT_LIST_ORDER when braced-initialized.
   */
   Move(const rc::ent::MovingEntities& movedEnts_,
-       std::unique_ptr<const rc::sol::IState> resultedSt_,
+       std::shared_ptr<const rc::sol::IState> resultedSt_,
+       unsigned idx_)
+      : Move(std::make_shared<const rc::ent::MovingEntities>(movedEnts_),
+             std::move(resultedSt_),
+             idx_) {}
+
+  /// Sharing the provided moved entities
+  Move(const std::shared_ptr<const rc::ent::MovingEntities>& movedEnts_,
+       std::shared_ptr<const rc::sol::IState> resultedSt_,
        unsigned idx_)
       : movedEnts{movedEnts_}, resultedSt{std::move(resultedSt_)}, idx{idx_} {
     using namespace std;
@@ -484,7 +1254,7 @@ class Move : public rc::sol::IMove {
     const rc::ent::BankEntities& receiverBank{(resultedSt->nextMoveFromLeft())
                                                   ? resultedSt->leftBank()
                                                   : resultedSt->rightBank()};
-    const set<unsigned>&movedIds{movedEnts.ids()},
+    const set<unsigned>&movedIds{movedEnts->ids()},
         &receiverBankIds{receiverBank.ids()};
 
     for (const unsigned movedId : movedIds)
@@ -496,7 +1266,7 @@ class Move : public rc::sol::IMove {
 
   Move(const rc::sol::IMove& other)
       :  ///< copy-ctor from the base IMove, not from Move
-        Move(other.movedEntities(),
+        Move(sharedMovedEntities(other),
              other.resultedState()->clone(),
              other.index()) {}
 
@@ -506,7 +1276,7 @@ class Move : public rc::sol::IMove {
   ///< copy assignment operator from the base IMove, not from Move
   Move& operator=(const rc::sol::IMove& other) noexcept {
     if (this != &other) {
-      movedEnts = other.movedEntities();
+      movedEnts = sharedMovedEntities(other);
       resultedSt = other.resultedState()->clone();
       idx = other.index();
     }
@@ -518,7 +1288,7 @@ class Move : public rc::sol::IMove {
 
   [[nodiscard]] const rc::ent::MovingEntities& movedEntities()
       const noexcept override {
-    return movedEnts;
+    return *movedEnts;
   }
 
   [[nodiscard]] std::shared_ptr<const rc::sol::IState> resultedState()
@@ -533,12 +1303,12 @@ class Move : public rc::sol::IMove {
     using namespace std;
 
     ostringstream oss;
-    if (!movedEnts.empty()) {
+    if (!movedEnts->empty()) {
       assert(idx != UINT_MAX);
       const char dirSign{(resultedSt->nextMoveFromLeft() ? '<' : '>')};
       const string dirStr(4ULL, dirSign);
       oss << "\n\n\t\ttransfer " << setw(3) << (1U + idx) << ":\t" << dirStr
-          << ' ' << movedEnts << ' ' << dirStr << "\n\n";
+          << ' ' << *movedEnts << ' ' << dirStr << "\n\n";
     }
     oss << resultedSt->toString(showNextMoveDir);
     return oss.str();
@@ -546,8 +1316,17 @@ class Move : public rc::sol::IMove {
 
   PROTECTED :
 
-      /// The moved entities
-      rc::ent::MovingEntities movedEnts;
+      /// @return the moved entities of `move`, shared when it is a Move
+      [[nodiscard]] static std::shared_ptr<const rc::ent::MovingEntities>
+      sharedMovedEntities(const rc::sol::IMove& move) {
+    if (const Move* const m{dynamic_cast<const Move*>(&move)})
+      return m->movedEnts;
+    return std::make_shared<const rc::ent::MovingEntities>(
+        move.movedEntities());
+  }
+
+  /// The moved entities
+  gsl::not_null<std::shared_ptr<const rc::ent::MovingEntities>> movedEnts;
 
   /// The resulted state
   gsl::not_null<std::shared_ptr<const rc::sol::IState>> resultedSt;
@@ -559,10 +1338,18 @@ class Move : public rc::sol::IMove {
 class ChainedMove : public Move {
  public:
   ChainedMove(const rc::ent::MovingEntities& movedEnts_,
-              std::unique_ptr<const rc::sol::IState> resultedSt_,
+              std::shared_ptr<const rc::sol::IState> resultedSt_,
               unsigned idx_,
               const std::shared_ptr<const ChainedMove>& prevMove = {})
       : Move(movedEnts_, std::move(resultedSt_), idx_), prev{prevMove} {}
+
+  /// Sharing the provided moved entities
+  ChainedMove(
+      const std::shared_ptr<const rc::ent::MovingEntities>& movedEnts_,
+      std::shared_ptr<const rc::sol::IState> resultedSt_,
+      unsigned idx_,
+      const std::shared_ptr<const ChainedMove>& prevMove = {})
+      : Move(movedEnts_, std::move(resultedSt_), idx_), prev{prevMove} {}
   ChainedMove(const ChainedMove&) = default;
   ChainedMove(ChainedMove&&) noexcept = default;
   ChainedMove& operator=(const ChainedMove&) = default;
@@ -607,6 +1394,16 @@ class Attempt : public rc::sol::IAttempt {
   }
   ~Attempt() noexcept override = default;
 
+  /// Copies the initial state and the first `movesCount` moves of `other`
+  Attempt(const Attempt& other, size_t movesCount)
+      : moves(std::cbegin(other.moves),
+              std::cbegin(other.moves) + ptrdiff_t(movesCount)) {
+    assert(other.initFakeMove && movesCount <= size(other.moves));
+    initFakeMove = std::make_unique<const Move>(*other.initFakeMove);
+    targetLeftBank =
+        std::make_unique<const rc::ent::BankEntities>(*other.targetLeftBank);
+  }
+
   Attempt(const Attempt&) = delete;
   Attempt(Attempt&&) = delete;
   void operator=(const Attempt&) = delete;
@@ -712,15 +1509,119 @@ class Attempt : public rc::sol::IAttempt {
   std::vector<Move> moves;  ///< the moves to be extended by the algorithm
 };
 
+/**
+Threads kept alive during the whole search, which run together the task they
+receive and then wait for the next one. Spares the parallel searches from
+starting new threads for every level.
+*/
+class WorkersPool {
+ public:
+  explicit WorkersPool(size_t workersCount) {
+    threads.reserve(workersCount);
+    for (size_t w{}; w < workersCount; ++w)
+      threads.emplace_back([this, w] { work(w); });
+  }
+
+  ~WorkersPool() noexcept {
+    {
+      const std::lock_guard lock{mtx};
+      stopping = true;
+    }
+    taskReady.notify_all();
+  }  // joins the threads
+
+  WorkersPool(const WorkersPool&) = delete;
+  WorkersPool(WorkersPool&&) = delete;
+  void operator=(const WorkersPool&) = delete;
+  void operator=(WorkersPool&&) = delete;
+
+  /// Count of the threads from the pool
+  [[nodiscard]] size_t size() const noexcept { return std::size(threads); }
+
+  /**
+  Runs task(w) for every w below workersCount, each on a different thread
+  from the pool, and waits for all of them to finish.
+  The task must not throw.
+  */
+  void run(size_t workersCount, const std::function<void(size_t)>& task) {
+    assert(workersCount <= size());
+    std::unique_lock lock{mtx};
+    crtTask = &task;
+    activeCount = pendingCount = workersCount;
+    ++generation;
+    lock.unlock();
+    taskReady.notify_all();
+
+    lock.lock();
+    taskDone.wait(lock, [this] { return !pendingCount; });
+    crtTask = nullptr;
+  }
+
+  PROTECTED :
+
+      /// Loop of the thread with index w
+      void
+      work(size_t w) {
+    size_t handledGeneration{};
+    for (;;) {
+      const std::function<void(size_t)>* task{};
+      {
+        std::unique_lock lock{mtx};
+        taskReady.wait(lock, [this, handledGeneration] {
+          return stopping || generation != handledGeneration;
+        });
+        if (stopping)
+          return;
+
+        handledGeneration = generation;
+        if (w >= activeCount)
+          continue;  // not needed this time
+        task = crtTask;
+      }
+
+      (*task)(w);
+
+      const std::lock_guard lock{mtx};
+      if (!--pendingCount)
+        taskDone.notify_one();
+    }
+  }
+
+  std::mutex mtx;  ///< guards the fields below
+  std::condition_variable taskReady;  ///< signals a new task or stopping
+  std::condition_variable taskDone;   ///< signals the end of a task
+
+  const std::function<void(size_t)>* crtTask{};  ///< the task being run
+  size_t activeCount{};   ///< how many threads run the current task
+  size_t pendingCount{};  ///< how many of them didn't finish yet
+  size_t generation{};    ///< count of the tasks received so far
+  bool stopping{};        ///< set when the pool gets destroyed
+
+  /// Declared last, to be joined before destroying the fields above
+  std::vector<std::jthread> threads;
+};
+
 /// Performs the required backtracking
 class Solver {
  public:
+  /**
+  @param threadsCount_ how many threads may explore the states in parallel
+  @param maxDfsProbes_ how many raft/bridge configurations the DFS may probe
+  before giving up. Only the sequential DFS can stop like this, so a limited
+  budget makes the DFS ignore threadsCount_
+  */
   Solver(const rc::ScenarioDetails& scenarioDetails_,
-         rc::Scenario::Results& results_)
+         rc::Scenario::Results& results_,
+         unsigned threadsCount_ = 1U,
+         size_t maxDfsProbes_ = SIZE_MAX)
       : scenarioDetails{&scenarioDetails_},
         results{&results_},
         SymTb{rc::InitialSymbolsTable()},
-        movingCfgsManager{scenarioDetails_, SymTb} {}
+        movingCfgsManager{scenarioDetails_, SymTb},
+        interchangeable{scenarioDetails_.interchangeableEntities()},
+        examinedStates{interchangeable},
+        threadsCount{std::max(threadsCount_, 1U)},
+        maxDfsProbes{maxDfsProbes_} {}
   ~Solver() noexcept = default;
 
   Solver(const Solver&) = delete;
@@ -730,7 +1631,13 @@ class Solver {
 
   /// Looks for a solution either through BFS or through DFS
   void run(bool usingBFS) {
-    using namespace std;
+    run(usingBFS ? rc::Scenario::Algorithm::BFS : rc::Scenario::Algorithm::DFS);
+  }
+
+  /// Looks for a solution using the provided algorithm
+  void run(rc::Scenario::Algorithm algorithm) {
+    using namespace std;
+    using enum rc::Scenario::Algorithm;
 
 #ifndef NDEBUG
     cout << "Exploring:\n";
@@ -742,10 +1649,54 @@ class Solver {
       targetLeftBank =
           make_unique<const rc::ent::BankEntities>(initSt->rightBank());
 
-      if (usingBFS)
-        ignore = bfsExplore(std::move(initSt));
-      else
-        ignore = dfsExplore(std::move(initSt));
+      switch (algorithm) {
+        case BFS:
+          if (const optional<unsigned> features{denseBfsFeatures(*initSt)})
+            ignore = denseExplore(BFS, std::move(initSt), *features);
+          else if (threadsCount > 1U)
+            ignore = parallelBfsExplore(std::move(initSt));
+          else
+            ignore = bfsExplore(std::move(initSt));
+          break;
+
+        case DFS:
+          if (threadsCount > 1U && maxDfsProbes == SIZE_MAX)
+            ignore = parallelDfsExplore(std::move(initSt));
+          else
+            ignore = dfsExplore(std::move(initSt));
+          break;
+
+        case AStar:
+          if (const optional<unsigned> features{denseBfsFeatures(*initSt)})
+            ignore = denseExplore(AStar, std::move(initSt), *features);
+          else
+            ignore = aStarExplore(std::move(initSt));
+          break;
+
+        case BidirectionalBFS:
+          if (bidirectionalBfsApplicable(*initSt))
+            ignore = bidirectionalBfsExplore(std::move(initSt));
+          else
+            ignore = bfsExplore(std::move(initSt));
+          break;
+
+        case UniformCost:
+          if (!rc::sol::AbsStateExt::selectExt<rc::sol::TimeStateExt>(
+                  initSt->getExtension().get()))
+            // without durations, fewest crossings is all that matters
+            ignore = bfsExplore(std::move(initSt));
+          else if (const optional<unsigned> features{
+                       denseBfsFeatures(*initSt)})
+            ignore = denseExplore(UniformCost, std::move(initSt), *features);
+          else
+            ignore = uniformCostExplore(std::move(initSt));
+          break;
+
+        default:
+          throw invalid_argument{HERE.function_name() +
+                                 " - Unknown algorithm: "s +
+                                 to_string((int)algorithm)};
+      }
     } catch (const exception& e) {
       cerr << "Couldn't solve the scenario due to: " << e.what() << endl;
       if (steps)
@@ -762,63 +1713,205 @@ class Solver {
     tests.
     */
     assert(results->investigatedStates > 0ULL);
-    const auto lim{size(examinedStates) - 1ULL};
-    for (auto i{0ULL}; i < lim; ++i) {
-      const auto& oneState = examinedStates[i];
-      for (auto j{i + 1ULL}; j <= lim; ++j) {
-        const auto& otherState = examinedStates[j];
-        if (otherState->handledBy(*oneState) ||
-            oneState->handledBy(*otherState)) {
-          cout << "Found duplicate/redundancy among the examined states:\n"
-               << *oneState << '\n'
-               << *otherState << endl;
-          assert(false);
-        }
+    examinedStates.checkNoRedundancy();
+#endif  // NDEBUG
+
+    publishAttempt();
+  }
+
+  /**
+  Continues the DFS which `run` or `loadDfs` left interrupted by its probes
+  budget, for a new budget of at most `maxProbes` probes. The statistics keep
+  accumulating within the same results.
+  The DFS continues sequentially, whatever `threadsCount`
+  */
+  void resumeDfs(size_t maxProbes) {
+    using namespace std;
+
+    assert(dfsMain && results->interrupted);
+    try {
+      const DfsProgress progress{dfsProbe(maxProbes)};
+      results->interrupted = progress == DfsProgress::OutOfProbes;
+    } catch (const exception& e) {
+      cerr << "Couldn't solve the scenario due to: " << e.what() << endl;
+      results->interrupted = false;
+      steps->clear();
+    }
+
+    publishAttempt();
+  }
+
+  /// Version of the form written by `saveDfs`, to be increased whenever it
+  /// changes
+  static constexpr unsigned DfsFormatVersion{1U};
+
+  /**
+  Writes the DFS interrupted by its probes budget in a form which `loadDfs`
+  accepts, even within another process. After a header with
+  `DfsFormatVersion` and the count of the frames, each frame gets a line
+  with the ids from the left bank of its state, how many of its raft/bridge
+  configurations were tried and the indices of those configurations.
+  The move leading to the state of a frame is the last tried configuration
+  of the previous frame, so the path needs no other line
+  */
+  void saveDfs(std::ostream& os) const {
+    using namespace std;
+
+    assert(dfsMain && results->interrupted);
+    const vector<DfsFrame>& frames{dfsMain->frames};
+    assert(size(frames) == dfsMain->steps->length() + 1ULL);
+
+    os << DfsFormTag << ' ' << DfsFormatVersion << '\n'
+       << size(frames) << '\n';
+    for (size_t i{}; i < size(frames); ++i) {
+      const set<unsigned>& leftIds{
+          (i ? dfsMain->steps->move(i - 1ULL).resultedState()
+             : dfsMain->steps->initialState())
+              ->leftBank()
+              .ids()};
+      os << size(leftIds);
+      for (const unsigned id : leftIds)
+        os << ' ' << id;
+
+      os << "  " << frames[i].nextCfgIdx << ' ' << size(frames[i].allowedCfgs);
+      for (const MovingConfigOption* cfgOption : frames[i].allowedCfgs)
+        os << ' ' << cfgOption->index();
+      os << '\n';
+    }
+  }
+
+  /**
+  Rebuilds the DFS saved by `saveDfs` for the same scenario, as interrupted by
+  its probes budget, so `resumeDfs` can continue it.
+  The moves of the path get replayed from the initial state, to provide their
+  states with all extensions. The form doesn't contain the states examined
+  outside the path, so the resumed DFS might examine some of them again, which
+  doesn't change whether it finds a solution.
+
+  @throw domain_error if the form is invalid or belongs to another scenario
+  */
+  void loadDfs(std::istream& is) {
+    using namespace std;
+    using namespace rc::sol;
+
+    const auto failure = [](const string& reason) {
+      return domain_error{HERE.function_name() + " - "s + reason};
+    };
+
+    string tag;
+    unsigned version{};
+    size_t framesCount{};
+    if (!(is >> tag >> version >> framesCount) || tag != DfsFormTag ||
+        version != DfsFormatVersion || !framesCount)
+      throw failure("Unknown form of the DFS!");
+
+    unique_ptr<const IState> initSt{
+        scenarioDetails->createInitialState(SymTb)};
+    targetLeftBank =
+        make_unique<const rc::ent::BankEntities>(initSt->rightBank());
+    dfsStart(std::move(initSt));
+
+    const vector<MovingConfigOption>& configs{movingCfgsManager.configs()};
+    for (size_t i{}; i < framesCount; ++i) {
+      if (i) {
+        // Replaying the last tried configuration of the previous frame
+        const DfsFrame& prevFrame{dfsMain->frames.back()};
+        if (!prevFrame.nextCfgIdx)
+          throw failure("The DFS path doesn't match its frames!");
+
+        const MovingConfigOption& cfgOption{
+            *prevFrame.allowedCfgs[prevFrame.nextCfgIdx - 1ULL]};
+        unique_ptr<const IState> nextState{
+            dfsMain->steps->lastMove().resultedState()->next(cfgOption.get())};
+        if (!nextState->valid(scenarioDetails->banksConstraints.get()) ||
+            dfsEnter(*dfsMain,
+                     Move(cfgOption.shared(), std::move(nextState),
+                          (unsigned)dfsMain->steps->length())) ||
+            size(dfsMain->frames) != i + 1ULL)
+          throw failure("The DFS path isn't an interrupted one!");
+      }
+
+      size_t leftIdsCount{};
+      if (!(is >> leftIdsCount))
+        throw failure("Missing frame of the DFS!");
+      set<unsigned> leftIds;
+      for (unsigned id{}; leftIdsCount-- > 0ULL && is >> id;)
+        leftIds.insert(id);
+      const IState& s{*dfsMain->steps->lastMove().resultedState()};
+      if (!is || leftIds != s.leftBank().ids())
+        throw failure("The DFS belongs to another scenario!");
+
+      // The saved configurations must be among the allowed ones
+      DfsFrame& frame{dfsMain->frames.back()};
+      const vector<const MovingConfigOption*> allowedCfgs{
+          std::move(frame.allowedCfgs)};
+      size_t cfgsCount{};
+      if (!(is >> frame.nextCfgIdx >> cfgsCount) ||
+          frame.nextCfgIdx > cfgsCount)
+        throw failure("Invalid frame of the DFS!");
+      frame.allowedCfgs.clear();
+      for (size_t idx{}; cfgsCount-- > 0ULL;) {
+        if (!(is >> idx) || idx >= size(configs) ||
+            ranges::find(allowedCfgs, &configs[idx]) == cend(allowedCfgs))
+          throw failure("Invalid raft/bridge configuration within the DFS!");
+        frame.allowedCfgs.push_back(&configs[idx]);
       }
     }
-#endif  // NDEBUG
 
-    if (steps)
-      results->attempt = steps;
-    else
-      results->attempt = make_shared<const Attempt>();
+    results->interrupted = true;
+    publishAttempt();
   }
 
   PROTECTED :
 
-      /**
-      This should be a newer / better state than the examined ones.
-      However, previous states that are inferior to this one should be removed.
-      Since this purge is executed for each new addition, there can be only 1
-      dominated state for each call - all previous states
-      were independent and dominant and now at most one of them
-      can become inferior to the provided state.
-      */
-      void
-      addExaminedState(std::unique_ptr<const rc::sol::IState> s) noexcept {
-    ++results->investigatedStates;  // needs to be counted in any case
-
-    auto it = begin(examinedStates);
-    const auto itEnd = end(examinedStates);
-    while ((it != itEnd) && (!(*it)->handledBy(*s)))
-      ++it;
+      /// Tag starting the form written by `saveDfs`
+      static constexpr std::string_view DfsFormTag{"RiverCrossingDfs"};
 
-    if (it == itEnd)
-      examinedStates.push_back(std::move(s));
+  /**
+  Provides `steps` to the results. An interrupted DFS still changes its
+  `steps` when resumed, so the results get a copy of them
+  */
+  void publishAttempt() {
+    if (!steps)
+      results->attempt = std::make_shared<const Attempt>();
+    else if (results->interrupted)
+      results->attempt = std::make_shared<const Attempt>(
+          *dfsMain->steps, dfsMain->steps->length());
     else
-      *it = std::move(s);
+      results->attempt = steps;
+  }
+
+  /**
+  This should be a newer / better state than the examined ones.
+  However, previous states that are inferior to this one should be removed.
+  */
+  void addExaminedState(std::shared_ptr<const rc::sol::IState> s) noexcept {
+    ++results->investigatedStates;  // needs to be counted in any case
+
+    examinedStates.add(std::move(s));
   }
 
   /// Updates the statistics to report and Symbols Table if necessary
   void commonTasksAddMove(const Move& move) noexcept {
+    commonTasksAddMove(move.movedEntities(), move.index(),
+                       *move.resultedState());
+  }
+
+  /**
+  Same as the overload above for the move with index `moveIdx`
+  (UINT_MAX for the fake initial move), which transfers `movedEnts` and
+  produces `resultedState`
+  */
+  void commonTasksAddMove(const rc::ent::MovingEntities& movedEnts,
+                          unsigned moveIdx,
+                          const rc::sol::IState& resultedState) noexcept {
     // wraps around for UINT_MAX
-    SymTb["CrossingIndex"] = double(move.index() + 2U);
+    SymTb[CrossingIndexSlot] = double(moveIdx + 2U);
 
-    move.movedEntities().getExtension()->addMovePostProcessing(SymTb);
-    results->update(
-        size_t(move.index() + 1U),  // wraps around for UINT_MAX
-        targetLeftBank->differencesCount(move.resultedState()->leftBank()),
-        move.resultedState()->leftBank(), minDistToGoal);
+    movedEnts.getExtension()->addMovePostProcessing(SymTb);
+    results->update(size_t(moveIdx + 1U),  // wraps around for UINT_MAX
+                    targetLeftBank->differencesCount(resultedState.leftBank()),
+                    resultedState.leftBank(), minDistToGoal);
   }
 
   /**
@@ -827,114 +1920,185 @@ class Solver {
 
   When moving from left to right, larger configs are favored, while at return,
   smaller configs are preferred.
+  Only the first from each class of equivalent configurations is kept.
   */
   void allowedMovingConfigurations(
       const rc::sol::IState& s,
-      std::vector<const rc::ent::MovingEntities*>& allowedCfgs) {
+      std::vector<const MovingConfigOption*>& allowedCfgs) {
     const rc::ent::BankEntities& crtBank{s.nextMoveFromLeft() ? s.leftBank()
                                                               : s.rightBank()};
     movingCfgsManager.configsForBank(crtBank, allowedCfgs,
                                      s.nextMoveFromLeft());
+    interchangeable.dropEquivalentConfigs(allowedCfgs);
   }
 
-  /**
-  Prepares the exploration of a move.
-  Cleans up when returning from dead ends.
+  /// Same as the overload above, except the dynamic validations use the
+  /// provided `st` Symbols Table instead of SymTb
+  void allowedMovingConfigurations(
+      const rc::sol::IState& s,
+      std::vector<const MovingConfigOption*>& allowedCfgs,
+      const rc::SymbolsTable& st) const {
+    const rc::ent::BankEntities& crtBank{s.nextMoveFromLeft() ? s.leftBank()
+                                                              : s.rightBank()};
+    movingCfgsManager.configsForBank(crtBank, allowedCfgs,
+                                     s.nextMoveFromLeft(), st);
+    interchangeable.dropEquivalentConfigs(allowedCfgs);
+  }
+
+  /// A state discovered by `bfsExplore`
+  struct BfsNode {
+    /// The discovered state, shared with `examinedStates`
+    std::shared_ptr<const rc::sol::IState> state;
+
+    /// The raft/bridge configuration which produced this state
+    gsl::not_null<const rc::ent::MovingEntities*> movingCfg;
 
-  Updates SymTb, examinedStates and steps accordingly.
+    /// Index of the state which produced this one; UINT_MAX for the initial
+    /// state
+    unsigned parent;
+
+    /// 0-based index of the move producing this state; UINT_MAX for the
+    /// initial state
+    unsigned moveIdx;
+  };
+
+  /**
+  @return true if a solution was found using BFS
+
+  The discovered states are appended to a vector of `BfsNode`-s, which acts as
+  an arena released all at once at the end of the search. The nodes refer
+  their parents by index and the raft/bridge configurations from
+  `movingCfgsManager` directly, so discovering a state allocates just the state,
+  which `examinedStates` shares. The moves of the solution are rebuilt only
+  at the end.
+  The nodes get expanded in the order of their discovery, like from a queue.
   */
-  class StepManager {
-   public:
-    StepManager(Solver& solver_, const Move& move)
-        : solver{&solver_}
-#ifndef NDEBUG
-          ,
-          _move{move}
-#endif  // NDEBUG
-    {
-#ifndef NDEBUG
-      using namespace std;
+  [[nodiscard]] bool bfsExplore(
+      std::unique_ptr<const rc::sol::IState> initialState) {
+    using namespace std;
+    using namespace rc::ent;
+    using namespace rc::sol;
 
-      cout << "\n\n";
+    addExaminedState(initialState->clone());
 
-      const unsigned moveIdx{move.index()};
-      if (UINT_MAX != moveIdx) {  // a normal move
-        assert(!move.movedEntities().empty());
-        assert((unsigned)solver->steps->length() == moveIdx);
-        assert(solver->steps->initialState());
+    // The fake empty move producing the initial state
+    const MovingEntities initialMove{
+        scenarioDetails->entities, {},
+        scenarioDetails->createMovingEntitiesExt()};
 
-        cout << *solver->steps->lastMove().resultedState() << "\n  DO move "
-             << (moveIdx + 1U) << " : " << move << endl;
+    vector<BfsNode> nodes;
+    nodes.push_back({std::move(initialState), &initialMove, UINT_MAX,
+                     UINT_MAX});  // UINT_MAX index for the fake initial move
 
-      } else {  // about to set the initial state through a fake empty move
-        assert(move.movedEntities().empty());
-        assert(!solver->steps->length());
-        assert(!solver->steps->initialState());
+    assert(!initialState);  // moved to nodes[0]
 
-        cout << "  DO initial fake empty move : " << move << endl;
-      }
+    vector<const MovingConfigOption*> allowedMovingConfigs;
+    for (size_t idx{}; idx < size(nodes); ++idx) {
+      // nodes might get reallocated below, unlike the states they point to
+      const IState& crtState{*nodes[idx].state};
+      const unsigned moveIdx{nodes[idx].moveIdx};
+
+#ifndef NDEBUG
+      cout << "\nDiscovering successors of move " << *nodes[idx].movingCfg
+           << " => " << crtState << endl;
 #endif  // NDEBUG
 
-      solver->steps->append(move);
-      if (solver->steps->isSolution()) {
-        commitStep();
-        return;  // no need to update the rest of the information now
-      }
+      commonTasksAddMove(*nodes[idx].movingCfg, moveIdx, crtState);
 
-      solver->commonTasksAddMove(move);
-      solver->addExaminedState(move.resultedState()->clone());
-    }
+      allowedMovingConfigurations(crtState, allowedMovingConfigs);
 
-    /// Reverts the dead-end move(step)
-    ~StepManager() noexcept {
-      if (committedStep())
-        return;
+      for (const MovingConfigOption* cfgOption : allowedMovingConfigs) {
+        assert(cfgOption);
+        const MovingEntities* const movingCfg{&cfgOption->get()};
+        unique_ptr<const IState> nextState{crtState.next(*movingCfg)};
 
-      // Dead end => backtracking
-      solver->steps->pop();
+#ifndef NDEBUG
+        cout << "\nProbing move " << *movingCfg << " => " << *nextState << endl;
+#endif  // NDEBUG
 
-      --solver->SymTb["CrossingIndex"];
+        if (!nextState->valid(scenarioDetails->banksConstraints.get()) ||
+            examinedStates.cover(*nextState))
+          continue;  // check next raft/bridge config
 
-      // Allowing the actions of the extensions
-      const gsl::not_null<const rc::ent::IMovingEntitiesExt*> previousMoveExt{
-          solver->steps->lastMove().movedEntities().getExtension()};
-      previousMoveExt->removeMovePostProcessing(solver->SymTb);
+        // Checking if the new state is a solution.
+        // Timing, bank and raft/bridge (capacity & load) constraints all
+        // conform here.
+        // Now it matters only if everyone reached the opposite bank
+        const bool solved{nextState->leftBank() == *targetLeftBank};
 
-#ifndef NDEBUG
-      using namespace std;
+        nodes.push_back({std::move(nextState), movingCfg, (unsigned)idx,
+                         1U + moveIdx});  // wraps around for UINT_MAX
+        if (!solved)
+          addExaminedState(nodes.back().state);
 
-      // _move.index() might return UINT_MAX, while CrossingIndex is reliable
-      cout << "\n\nUNDO move " << solver->SymTb["CrossingIndex"] << " : "
-           << _move << endl;
-#endif  // NDEBUG
+        if (solved) {
+          // Found an optimal solution
+          steps = make_shared<Attempt>(*bfsChainedMoves(nodes));
+          return true;
+        }
+      }
     }
 
-    StepManager(const StepManager&) = delete;
-    StepManager(StepManager&&) = delete;
-    void operator=(const StepManager&) = delete;
-    void operator=(StepManager&&) = delete;
+    return false;
+  }
 
-    void commitStep() noexcept { committed = true; }  ///< marks the move as ok
-    [[nodiscard]] bool committedStep() const noexcept { return committed; }
+  /// @return the chained moves leading to the last node from `nodes`, whose
+  /// states are moved into the result
+  [[nodiscard]] std::shared_ptr<const ChainedMove> bfsChainedMoves(
+      std::vector<BfsNode>& nodes) const {
+    using namespace std;
+    using namespace rc::ent;
 
-    PROTECTED :
+    vector<size_t> path;
+    for (size_t idx{size(nodes) - 1ULL}; idx != UINT_MAX;
+         idx = nodes[idx].parent)
+      path.push_back(idx);
+
+    // path.back() is the initial state, produced by the fake initial move
+    // which isn't among the configurations from movingCfgsManager
+    BfsNode& initialNode{nodes[path.back()]};
+    shared_ptr<const ChainedMove> result{make_shared<const ChainedMove>(
+        *initialNode.movingCfg, std::move(initialNode.state),
+        initialNode.moveIdx)};
+    for (auto it = next(crbegin(path)); it != crend(path); ++it) {
+      BfsNode& node{nodes[*it]};
+      result = make_shared<const ChainedMove>(
+          movingCfgsManager.sharedConfig(*node.movingCfg),
+          std::move(node.state), node.moveIdx, result);
+    }
+    return result;
+  }
 
-        /// Parent outer class
-        gsl::not_null<Solver*>
-            solver;
+  /// The parallel BFS starts a thread for every this many states of a level
+  static constexpr size_t MinStatesPerBfsWorker{4ULL};
 
-#ifndef NDEBUG
-    Move _move;
-#endif  // NDEBUG
+  /// A valid successor of a state, together with the move producing it
+  struct BfsSuccessor {
+    /// The raft/bridge configuration of the move
+    gsl::not_null<const MovingConfigOption*> cfgOption;
 
-    /// Was the move(step) ok or it should be reverted?
-    bool committed{};
+    std::unique_ptr<const rc::sol::IState> state;  ///< the resulted state
   };
 
-  friend class StepManager;
-
-  /// @return true if a solution was found using BFS
-  [[nodiscard]] bool bfsExplore(
+  /**
+  Same exploration as `bfsExplore`, except the states reached after the same
+  number of moves get expanded by up to `threadsCount` threads.
+
+  Each level is handled in 2 phases:
+  - the threads generate the valid successors of the states from the level,
+  each thread using its own Symbols Table. The successors covered by the
+  states examined before the level are dropped already here
+  - the successors are then filtered and enqueued sequentially, in the order of
+  their parents, exactly as `bfsExplore` would do it
+
+  Covering is monotonic (a state handled by a removed examined state is also
+  handled by the state which removed it), so the prefiltering from the first
+  phase doesn't change anything. Thus the solution and the statistics are the
+  ones from `bfsExplore`, no matter the number of threads.
+
+  @return true if a solution was found
+  */
+  [[nodiscard]] bool parallelBfsExplore(
       std::unique_ptr<const rc::sol::IState> initialState) {
     using namespace std;
     using namespace rc::ent;
@@ -942,138 +2106,1954 @@ class Solver {
 
     addExaminedState(initialState->clone());
 
-    queue<shared_ptr<const ChainedMove>> movesToExplore;
-
     // The initial entry is the fake move producing initial state
-    movesToExplore.push(make_shared<const ChainedMove>(
+    vector<shared_ptr<const ChainedMove>> level{make_shared<const ChainedMove>(
         MovingEntities(scenarioDetails->entities, {},
                        scenarioDetails->createMovingEntitiesExt()),
         std::move(initialState),
-        UINT_MAX));  // UINT_MAX index required for the fake initial move
+        UINT_MAX)};  // UINT_MAX index required for the fake initial move
 
-    assert(!initialState);  // moved to movesToExplore[0]
+    assert(!initialState);  // moved to level[0]
 
     do {
-      const shared_ptr<const ChainedMove> move{movesToExplore.front()};
-      movesToExplore.pop();
+      if (exploreBfsLevel(level))
+        return true;
+    } while (!level.empty());
 
-#ifndef NDEBUG
-      cout << "\nDiscovering successors of move:\n" << *move << endl;
-#endif  // NDEBUG
+    return false;
+  }
 
-      commonTasksAddMove(*move);
+  /**
+  Replaces the states from `level` with their successors not covered by the
+  examined states. See `parallelBfsExplore`.
 
-      const shared_ptr<const IState> crtState{move->resultedState()};
-      vector<const MovingEntities*> allowedMovingConfigs;
-      allowedMovingConfigurations(*crtState, allowedMovingConfigs);
+  @return true if a solution was found
+  */
+  [[nodiscard]] bool exploreBfsLevel(
+      std::vector<std::shared_ptr<const ChainedMove>>& level) {
+    using namespace std;
+    using namespace rc::ent;
 
-      for (const MovingEntities* movingCfg : allowedMovingConfigs) {
-        assert(movingCfg);
-        unique_ptr<const IState> nextState{crtState->next(*movingCfg)};
+    vector<vector<BfsSuccessor>> successors(size(level));
+    expandLevel(level, successors);
 
-#ifndef NDEBUG
-        cout << "\nProbing move " << *movingCfg << " => " << *nextState << endl;
-#endif  // NDEBUG
+    vector<shared_ptr<const ChainedMove>> nextLevel;
+    for (size_t idx{}; idx < size(level); ++idx) {
+      const shared_ptr<const ChainedMove>& move{level[idx]};
+      results->update(
+          size_t(move->index() + 1U),  // wraps around for UINT_MAX
+          targetLeftBank->differencesCount(move->resultedState()->leftBank()),
+          move->resultedState()->leftBank(), minDistToGoal);
 
-        if (!nextState->valid(scenarioDetails->banksConstraints.get()) ||
-            nextState->handledBy(examinedStates))
-          continue;  // check next raft/bridge config
+      for (BfsSuccessor& successor : successors[idx]) {
+        if (examinedStates.cover(*successor.state))
+          continue;  // covered by a state from the current or next level
 
         const shared_ptr<const ChainedMove> validNextMove{
             make_shared<const ChainedMove>(
-                MovingEntities(scenarioDetails->entities, movingCfg->ids(),
-                               movingCfg->getExtension()->clone()),
-                std::move(nextState),
+                successor.cfgOption->shared(),
+                std::move(successor.state),
                 1U + move->index(),  // wraps around for UINT_MAX
                 move)};
 
-        assert(!nextState);  // moved to validNextMove
-
-        // Checking if the new state is a solution.
-        // Timing, bank and raft/bridge (capacity & load) constraints all
-        // conform here.
-        // Now it matters only if everyone reached the opposite bank
         if (validNextMove->resultedState()->leftBank() == *targetLeftBank) {
           // Found an optimal solution
           steps = make_shared<Attempt>(*validNextMove);
           return true;
         }
 
-        movesToExplore.push(validNextMove);
-        addExaminedState(validNextMove->resultedState()->clone());
+        nextLevel.push_back(validNextMove);
+        addExaminedState(validNextMove->resultedState());
       }
-    } while (!movesToExplore.empty());
+    }
 
+    level = std::move(nextLevel);
     return false;
   }
 
-  /// @return true if a solution was found using DFS
-  [[nodiscard]] bool dfsExplore(const Move& move) {
+  /// @return the threads of the parallel searches, started on first use
+  [[nodiscard]] WorkersPool& workersPool() {
+    if (!workers)
+      workers = std::make_unique<WorkersPool>(threadsCount);
+    return *workers;
+  }
+
+  /**
+  First phase of `parallelBfsExplore`: fills successors[i] with the valid
+  successors of level[i] not covered by the already examined states.
+  Only reads `examinedStates`, which isn't modified meanwhile.
+  */
+  void expandLevel(
+      const std::vector<std::shared_ptr<const ChainedMove>>& level,
+      std::vector<std::vector<BfsSuccessor>>& successors) {
     using namespace std;
     using namespace rc::ent;
     using namespace rc::sol;
 
-    StepManager stepManager{*this, move};
-    if (stepManager.committedStep())
-      return true;  // discovered solution and committed the given final move
+    atomic<size_t> nextIdx{};
+    const auto expandSome = [&]() {
+      rc::SymbolsTable st{SymTb};
+      vector<const MovingConfigOption*> allowedMovingConfigs;
+      for (size_t idx{nextIdx++}; idx < size(level); idx = nextIdx++) {
+        const ChainedMove& move{*level[idx]};
+
+        // Same SymTb updates as in `commonTasksAddMove`
+        // wraps around for UINT_MAX
+        st[CrossingIndexSlot] = double(move.index() + 2U);
+        move.movedEntities().getExtension()->addMovePostProcessing(st);
+
+        const shared_ptr<const IState> crtState{move.resultedState()};
+        movingCfgsManager.configsForBank(crtState->nextMoveFromLeft()
+                                             ? crtState->leftBank()
+                                             : crtState->rightBank(),
+                                         allowedMovingConfigs,
+                                         crtState->nextMoveFromLeft(), st);
+        interchangeable.dropEquivalentConfigs(allowedMovingConfigs);
+
+        for (const MovingConfigOption* cfgOption : allowedMovingConfigs) {
+          assert(cfgOption);
+          const MovingEntities* const movingCfg{&cfgOption->get()};
+          unique_ptr<const IState> nextState{crtState->next(*movingCfg)};
+          if (!nextState->valid(scenarioDetails->banksConstraints.get()) ||
+              examinedStates.cover(*nextState))
+            continue;  // check next raft/bridge config
+
+          successors[idx].push_back({cfgOption, std::move(nextState)});
+        }
+      }
+    };
 
-    const shared_ptr<const IState> crtState{move.resultedState()};
-    vector<const MovingEntities*> allowedMovingConfigs;
-    allowedMovingConfigurations(*crtState, allowedMovingConfigs);
+    // Small levels don't deserve the cost of waking up the workers
+    const size_t workersCount{
+        min(size_t(threadsCount), size(level) / MinStatesPerBfsWorker)};
+    if (workersCount <= 1ULL) {
+      expandSome();
+      return;
+    }
 
-    for (const MovingEntities* movingCfg : allowedMovingConfigs) {
-      assert(movingCfg);
-      unique_ptr<const IState> nextState{crtState->next(*movingCfg)};
+    vector<exception_ptr> failures(workersCount);
+    workersPool().run(workersCount, [&](size_t w) noexcept {
+      try {
+        expandSome();
+      } catch (...) {
+        failures[w] = current_exception();
+        nextIdx = size(level);  // lets the other workers stop early
+      }
+    });
 
-#ifndef NDEBUG
-      cout << "\nSimulating move " << *movingCfg << " => " << *nextState
-           << endl;
-#endif  // NDEBUG
+    for (const exception_ptr& failure : failures)
+      if (failure)
+        rethrow_exception(failure);
+  }
 
-      if (!nextState->valid(scenarioDetails->banksConstraints.get()) ||
-          nextState->handledBy(examinedStates))
-        continue;  // check next raft/bridge config
+  /// Dense BFS is used only up to this many entities (the visited bitmap needs
+  /// 2^(MaxDenseBfsEntities+1) bits)
+  static constexpr size_t MaxDenseBfsEntities{28ULL};
 
-      if (dfsExplore(Move(*movingCfg, std::move(nextState),
-                          (unsigned)steps->length()))) {
-        stepManager.commitStep();
-        return true;
-      }
+  /// The dense BFS for time-aware states keeps the earliest time for at most
+  /// this many slots
+  static constexpr size_t MaxTimedDenseBfsSlots{1ULL << 24U};
+
+  /**
+  Features of the scenario selecting the dense kernels (see `DenseSearch`).
+  Each combination of them has its own instantiation of `denseBfsExplore`,
+  `denseUniformCostExplore` and `denseAStarExplore`
+  */
+  enum DenseBfsFeature : unsigned {
+    DenseBfsTimed = 1U,             ///< the states have a TimeStateExt
+    DenseBfsPrevLoad = 2U,          ///< the states have a PrevLoadStateExt
+    DenseBfsBanksConstraints = 4U,  ///< the banks have constraints
+    DenseBfsFeaturesCombinations = 8U  ///< count of the combinations of these
+  };
+
+  /**
+  @return the features (see `DenseBfsFeature`) of the dense kernels able to
+  explore from `initialState` or nothing if the dense kernels don't apply.
+  The entities must be few enough and the states may extend only the time
+  and / or the previous raft/bridge load, which the dense BFS keeps inline.
+  Then any state is fully described by its left bank, its next move direction
+  and those values, so it can be ranked within a flat table.
+  */
+  [[nodiscard]] std::optional<unsigned> denseBfsFeatures(
+      const rc::sol::IState& initialState) const noexcept {
+    using namespace std;
+    using namespace rc::sol;
+
+    const rc::ent::AllEntities& entities{*scenarioDetails->entities};
+    if (!entities.masksAllowed() || entities.count() > MaxDenseBfsEntities)
+      return {};
+
+    unsigned features{scenarioDetails->banksConstraints
+                          ? (unsigned)DenseBfsBanksConstraints
+                          : 0U};
+    const shared_ptr<const IStateExt> ext{initialState.getExtension()};
+    if (dynamic_pointer_cast<const DefStateExt>(ext))
+      return features;
+
+    // TimeStateExt and PrevLoadStateExt are the only state extensions
+    const shared_ptr<const PrevLoadStateExt> prevLoadExt{
+        AbsStateExt::selectExt<PrevLoadStateExt>(ext)};
+    if (prevLoadExt) {
+      if (!isnan(prevLoadExt->prevRaftLoad()))
+        return {};  // exploring only from the initial state
+      features |= DenseBfsPrevLoad;
     }
 
-    return false;
+    // The states without known durations get reported by the general BFS
+    if (AbsStateExt::selectExt<TimeStateExt>(ext)) {
+      if (scenarioDetails->ctdItems.empty())
+        return {};
+      features |= DenseBfsTimed;
+    }
+
+    if (!(features & (DenseBfsPrevLoad | DenseBfsTimed)))
+      return {};  // unknown extensions
+
+    // There are at most as many distinct loads as configurations
+    const size_t loadSlots{(features & DenseBfsPrevLoad)
+                               ? size(movingCfgsManager.configs()) + 1ULL
+                               : 1ULL},
+        slotsCount{(size_t(1ULL) << (entities.count() + 1ULL)) * loadSlots};
+    if (slotsCount > ((features & DenseBfsTimed)
+                          ? MaxTimedDenseBfsSlots
+                          : (size_t(1ULL) << (MaxDenseBfsEntities + 1ULL))))
+      return {};
+
+    return features;
   }
 
-  /// Pretends the initial state is the result of a previous move (empty
-  /// raft/bridge)
-  [[nodiscard]] bool dfsExplore(
-      std::unique_ptr<const rc::sol::IState> initialState) {
-    steps = std::make_shared<Attempt>();
+  /// @return true if the dense BFS can explore from `initialState`
+  [[nodiscard]] bool denseBfsApplicable(
+      const rc::sol::IState& initialState) const noexcept {
+    return denseBfsFeatures(initialState).has_value();
+  }
 
-    return dfsExplore(Move(
-        rc::ent::MovingEntities{scenarioDetails->entities,
-                                {},
-                                scenarioDetails->createMovingEntitiesExt()},
-        std::move(initialState),
-        UINT_MAX));  // UINT_MAX index required for the fake initial move
+  /**
+  Runs the dense kernel of `algorithm` for the provided `features`.
+  Only BFS, UniformCost (for time-aware states) and AStar have such kernels
+  */
+  [[nodiscard]] bool denseExplore(
+      rc::Scenario::Algorithm algorithm,
+      std::unique_ptr<const rc::sol::IState> initialState,
+      unsigned features) {
+    using enum rc::Scenario::Algorithm;
+    using Kernel = bool (Solver::*)(std::unique_ptr<const rc::sol::IState>);
+    using Kernels = std::array<Kernel, DenseBfsFeaturesCombinations>;
+    static constexpr auto kernels{
+        []<size_t... Features>(std::index_sequence<Features...>) {
+          return std::array<Kernels, 3ULL>{
+              Kernels{&Solver::denseBfsExplore<(unsigned)Features>...},
+              Kernels{&Solver::denseUniformCostExplore<(unsigned)Features>...},
+              Kernels{&Solver::denseAStarExplore<(unsigned)Features>...}};
+        }(std::make_index_sequence<DenseBfsFeaturesCombinations>{})};
+
+    assert(features < DenseBfsFeaturesCombinations);
+    assert(algorithm != UniformCost || (features & DenseBfsTimed));
+    const size_t kernelsIdx{algorithm == BFS           ? 0ULL
+                            : algorithm == UniformCost ? 1ULL
+                                                       : 2ULL};
+    assert(kernelsIdx < 2ULL || algorithm == AStar);
+    return (this->*kernels[kernelsIdx][features])(std::move(initialState));
   }
 
-  /// The details of the scenario
-  gsl::not_null<const rc::ScenarioDetails*> scenarioDetails;
+  /// A state discovered by the dense or by the bidirectional BFS
+  struct DenseBfsNode {
+    rc::ent::IdsMask leftBank;  ///< the entities on the left bank
 
-  /// The results for the scenario
-  gsl::not_null<rc::Scenario::Results*> results;
+    /// The raft/bridge configuration which produced this state
+    gsl::not_null<const rc::ent::MovingEntities*> movingCfg;
 
-  rc::SymbolsTable SymTb;  ///< the Symbols Table
+    /// Index of the state which produced this one; UINT_MAX for the states
+    /// where the search started
+    unsigned parent;
 
-  /// Provides the possible raft configurations for a new move
-  MovingConfigsManager movingCfgsManager;
+    bool nextMoveFromLeft;  ///< the direction of the next move
+  };
 
-  /// Ensures the algorithm doesn't retry a path twice
-  std::vector<std::unique_ptr<const rc::sol::IState>> examinedStates;
+  /// A successor found by a dense kernel, before being appended to the nodes
+  struct DenseBfsSuccessor {
+    rc::ent::IdsMask leftBank;  ///< the entities on the left bank
 
-  /// The current evolution of the algorithm
-  std::shared_ptr<rc::sol::IAttempt> steps;
+    /// The raft/bridge configuration which produces this state
+    gsl::not_null<const rc::ent::MovingEntities*> movingCfg;
+
+    size_t slot;            ///< its slot within the table of the dense kernel
+    unsigned parent;        ///< index of the state producing this one
+    unsigned time;          ///< its time, for time-aware states
+    unsigned loadSlot;      ///< its load slot, for states with a previous load
+    bool nextMoveFromLeft;  ///< the direction of the next move
+  };
+
+  /// What the dense kernels need to know about a raft/bridge configuration
+  struct DenseBfsConfigTraits {
+    unsigned duration{};  ///< the crossing duration
+    unsigned loadId{};    ///< the index of its load among the distinct loads
+  };
+
+  /**
+  The flat table replacing `examinedStates` for the dense kernels, together
+  with the discovered states, for the scenarios with the provided `Features`.
+
+  The table contains a slot for every left bank, next move direction and
+  previous load, where the initial state has its own load slot.
+  A slot of a time-aware state holds the earliest time it was reached.
+  Like for `ExaminedStates::cover`, a state is covered by a slot reached
+  not later and with the same previous load or by the initial state.
+
+  The states are `DenseBfsNode`-s, which refer their parents by index,
+  instead of `ChainedMove` chains. Their times and previous loads are kept
+  in parallel vectors. The durations and loads of the configurations are
+  resolved only once, so the dense kernels perform neither virtual calls on
+  the state extensions, nor RTTI.
+  */
+  template <unsigned Features>
+  struct DenseSearch {
+    static constexpr bool Timed{(Features & DenseBfsTimed) != 0U},
+        WithPrevLoad{(Features & DenseBfsPrevLoad) != 0U},
+        WithBanksConstraints{(Features & DenseBfsBanksConstraints) != 0U};
+
+    /// Visited slots or, for time-aware states, the earliest time of each slot
+    using Slots = std::
+        conditional_t<Timed, std::vector<unsigned>, std::vector<bool>>;
+
+    /**
+    Prepares the table for the scenario of `solver` and adds the node of
+    `initialState`, produced by the fake empty move `initialMove`.
+    The initial state isn't marked as examined yet
+    @throw domain_error when some configuration has no crossing duration
+    */
+    DenseSearch(const Solver& solver,
+                const rc::sol::IState& initialState,
+                const rc::ent::MovingEntities& initialMove)
+        : interchangeable{&solver.interchangeable} {
+      using namespace std;
+      using namespace rc::ent;
+      using namespace rc::sol;
+
+      size_t loadsCount{};
+      if constexpr (Timed || WithPrevLoad) {
+        const vector<MovingConfigOption>& configs{
+            solver.movingCfgsManager.configs()};
+        cfgsTraits.resize(size(configs));
+        vector<double> cfgsLoads;
+        if constexpr (WithPrevLoad) {
+          for (const MovingConfigOption& cfgOption : configs)
+            cfgsLoads.push_back(AbsMovingEntitiesExt::selectExt<TotalLoadExt>(
+                                    cfgOption.get().getExtension())
+                                    ->totalLoad());
+          cfgsLoads = distinctLoads(std::move(cfgsLoads));
+          loadsCount = size(cfgsLoads);
+        }
+
+        for (const MovingConfigOption& cfgOption : configs) {
+          const MovingEntities& cfg{cfgOption.get()};
+          DenseBfsConfigTraits& cfgTraits{cfgsTraits[cfgOption.index()]};
+          if constexpr (Timed) {
+            const CrossingDurationExt* const durationExt{
+                AbsMovingEntitiesExt::selectExt<CrossingDurationExt>(
+                    cfg.getExtension())};
+            if (!durationExt || !durationExt->crossingDuration())
+              throw domain_error{
+                  HERE.function_name() +
+                  " - Provided CrossingDurationsOfConfigurations items don't "
+                  "cover raft configuration: "s +
+                  cfg.toString()};
+            cfgTraits.duration = *durationExt->crossingDuration();
+          }
+          if constexpr (WithPrevLoad)
+            cfgTraits.loadId =
+                *loadIdIn(cfgsLoads,
+                          AbsMovingEntitiesExt::selectExt<TotalLoadExt>(
+                              cfg.getExtension())
+                              ->totalLoad());
+        }
+      }
+
+      // The initial state has no previous load and gets the last load slot
+      loadSlots = loadsCount + 1ULL;
+      slots = Slots((size_t(1ULL)
+                     << (solver.scenarioDetails->entities->count() + 1ULL)) *
+                        loadSlots,
+                    typename Slots::value_type(Timed ? UINT_MAX : 0U));
+
+      nodes.push_back(
+          {*initialState.leftBank().idsMask(), &initialMove, UINT_MAX, true});
+      if constexpr (Timed)
+        nodesTimes.push_back(AbsStateExt::selectExt<TimeStateExt>(
+                                 initialState.getExtension().get())
+                                 ->time());
+      if constexpr (WithPrevLoad)
+        nodesLoadSlots.push_back((unsigned)initialLoadSlot());
+    }
+    ~DenseSearch() noexcept = default;
+
+    DenseSearch(const DenseSearch&) = delete;
+    DenseSearch(DenseSearch&&) = delete;
+    void operator=(const DenseSearch&) = delete;
+    void operator=(DenseSearch&&) = delete;
+
+    /// @return the load slot of the initial state
+    [[nodiscard]] size_t initialLoadSlot() const noexcept {
+      return loadSlots - 1ULL;
+    }
+
+    /// @return the slot for the provided left bank, direction and load slot.
+    /// Equivalent states (see InterchangeableEntities) share their slot
+    [[nodiscard]] size_t slotOf(rc::ent::IdsMask leftBank,
+                                bool nextMoveFromLeft,
+                                size_t loadSlot) const noexcept {
+      return size_t((interchangeable->canonical(leftBank) << 1) |
+                    (nextMoveFromLeft ? 1ULL : 0ULL)) *
+                 loadSlots +
+             loadSlot;
+    }
+
+    /// @return the time of nodes[idx] or 0 for states without time
+    [[nodiscard]] unsigned nodeTime(size_t idx) const noexcept {
+      if constexpr (Timed)
+        return nodesTimes[idx];
+      else
+        return 0U;
+    }
+
+    /// @return the load slot of nodes[idx]
+    [[nodiscard]] size_t nodeLoadSlot(size_t idx) const noexcept {
+      if constexpr (WithPrevLoad)
+        return nodesLoadSlots[idx];
+      else
+        return initialLoadSlot();
+    }
+
+    /// @return the slot of nodes[idx]
+    [[nodiscard]] size_t nodeSlot(size_t idx) const noexcept {
+      return slotOf(nodes[idx].leftBank, nodes[idx].nextMoveFromLeft,
+                    nodeLoadSlot(idx));
+    }
+
+    /// @return true if `slot` was reached not later than `time`
+    [[nodiscard]] bool covers(size_t slot, unsigned time) const noexcept {
+      if constexpr (Timed)
+        return slots[slot] <= time;
+      else
+        return (bool)slots[slot];
+    }
+
+    /// @return true if the state with the provided left bank, direction,
+    /// slot and time is covered by a reached slot
+    [[nodiscard]] bool covers(rc::ent::IdsMask leftBank,
+                              bool nextMoveFromLeft,
+                              size_t slot,
+                              unsigned time) const noexcept {
+      if (covers(slot, time))
+        return true;
+      if constexpr (WithPrevLoad)
+        return covers(slotOf(leftBank, nextMoveFromLeft, initialLoadSlot()),
+                      time);
+      else
+        return false;
+    }
+
+    /// @return true if `successor` is covered by a reached slot
+    [[nodiscard]] bool covers(
+        const DenseBfsSuccessor& successor) const noexcept {
+      return covers(successor.leftBank, successor.nextMoveFromLeft,
+                    successor.slot, successor.time);
+    }
+
+    /// @return true if nodes[idx] is covered by a reached slot
+    [[nodiscard]] bool coversNode(size_t idx) const noexcept {
+      return covers(nodes[idx].leftBank, nodes[idx].nextMoveFromLeft,
+                    nodeSlot(idx), nodeTime(idx));
+    }
+
+    /// Marks `slot` as reached at `time`
+    void reach(size_t slot, unsigned time) noexcept {
+      if constexpr (Timed)
+        slots[slot] = time;
+      else
+        slots[slot] = true;
+    }
+
+    /// Appends the node of `successor`
+    void add(const DenseBfsSuccessor& successor) {
+      nodes.push_back({successor.leftBank, successor.movingCfg,
+                       successor.parent, successor.nextMoveFromLeft});
+      if constexpr (Timed)
+        nodesTimes.push_back(successor.time);
+      if constexpr (WithPrevLoad)
+        nodesLoadSlots.push_back(successor.loadSlot);
+    }
+
+    /// Considers equivalent the states differing by interchangeable entities
+    gsl::not_null<const InterchangeableEntities*> interchangeable;
+
+    /// Indexed like the configurations from `movingCfgsManager`
+    std::vector<DenseBfsConfigTraits> cfgsTraits;
+
+    size_t loadSlots{1ULL};  ///< the distinct loads plus the initial slot
+
+    Slots slots;  ///< the table
+
+    std::vector<DenseBfsNode> nodes;  ///< the discovered states
+
+    /// The times and the load slots of the nodes, when needed
+    std::vector<unsigned> nodesTimes, nodesLoadSlots;
+  };
+
+  /**
+  Calls visit(successor) for the successors of ds.nodes[idx], which was
+  reached after `depth` moves, which are valid and not covered by the slots
+  yet, until visit returns true.
+  Only reads `ds`, using its own Symbols Table `st`
+  */
+  template <unsigned Features, class Visit>
+  void denseExpand(const DenseSearch<Features>& ds,
+                   size_t idx,
+                   size_t depth,
+                   rc::SymbolsTable& st,
+                   std::vector<const MovingConfigOption*>& cfgs,
+                   Visit&& visit) const {
+    using namespace std;
+    using namespace rc::ent;
+
+    const shared_ptr<const AllEntities>& entities{scenarioDetails->entities};
+    const IdsMask allMask{entities->fullMask()};
+    const rc::cond::ConfigConstraints* banksConstraints{
+        scenarioDetails->banksConstraints.get()};
+    assert(DenseSearch<Features>::WithBanksConstraints ==
+           (banksConstraints != nullptr));
+
+    // The node fields get copied, as `visit` might append to ds.nodes
+    const bool nextMoveFromLeft{ds.nodes[idx].nextMoveFromLeft};
+    const IdsMask leftMask{ds.nodes[idx].leftBank};
+    const unsigned time{ds.nodeTime(idx)};
+
+    // Same SymTb updates as in `commonTasksAddMove`
+    st[CrossingIndexSlot] = double(depth + 1ULL);
+    ds.nodes[idx].movingCfg->getExtension()->addMovePostProcessing(st);
+
+    movingCfgsManager.configsForBank(
+        BankEntities{entities,
+                     nextMoveFromLeft ? leftMask : (allMask & ~leftMask)},
+        cfgs, nextMoveFromLeft, st);
+    interchangeable.dropEquivalentConfigs(cfgs);
+
+    for (const MovingConfigOption* cfgOption : cfgs) {
+      assert(cfgOption);
+      const MovingEntities* const movingCfg{&cfgOption->get()};
+      unsigned nextTime{};
+      size_t nextLoadSlot{ds.initialLoadSlot()};
+      if constexpr (DenseSearch<Features>::Timed ||
+                    DenseSearch<Features>::WithPrevLoad) {
+        const DenseBfsConfigTraits& cfgTraits{
+            ds.cfgsTraits[cfgOption->index()]};
+        if constexpr (DenseSearch<Features>::Timed) {
+          nextTime = time + cfgTraits.duration;
+          if (nextTime > scenarioDetails->maxDuration)
+            continue;  // check next raft/bridge config
+        }
+        if constexpr (DenseSearch<Features>::WithPrevLoad)
+          nextLoadSlot = cfgTraits.loadId;
+      }
+
+      const IdsMask movedMask{*movingCfg->idsMask()};
+      const IdsMask nextLeftMask{nextMoveFromLeft ? (leftMask & ~movedMask)
+                                                  : (leftMask | movedMask)};
+      const DenseBfsSuccessor successor{
+          nextLeftMask,
+          movingCfg,
+          ds.slotOf(nextLeftMask, !nextMoveFromLeft, nextLoadSlot),
+          (unsigned)idx,
+          nextTime,
+          (unsigned)nextLoadSlot,
+          !nextMoveFromLeft};
+      if (ds.covers(successor))
+        continue;  // check next raft/bridge config
+
+      if constexpr (DenseSearch<Features>::WithBanksConstraints)
+        if (!banksConstraints->check(BankEntities{entities, nextLeftMask}) ||
+            !banksConstraints->check(
+                BankEntities{entities, allMask & ~nextLeftMask}))
+          continue;  // check next raft/bridge config
+
+      if (visit(successor))
+        return;
+    }
+  }
+
+  /// Updates the statistics like `commonTasksAddMove` for ds.nodes[idx],
+  /// which was reached after `depth` moves
+  template <unsigned Features>
+  void denseUpdateResults(const DenseSearch<Features>& ds,
+                          size_t idx,
+                          size_t depth) {
+    const rc::ent::BankEntities leftBank{scenarioDetails->entities,
+                                         ds.nodes[idx].leftBank};
+    results->update(depth, targetLeftBank->differencesCount(leftBank),
+                    leftBank, minDistToGoal);
+  }
+
+  /**
+  Same exploration as `bfsExplore` for the scenarios accepted by
+  `denseBfsFeatures`, which provide the `Features` of this instantiation.
+  The states are kept in a `DenseSearch`, whose slots get reached when
+  the states are discovered. The solution moves are rebuilt only at the end.
+
+  For `threadsCount` above 1, the large levels get expanded like in
+  `parallelBfsExplore`, so the solution and the statistics don't depend on
+  the number of threads.
+
+  @return true if a solution was found
+  */
+  template <unsigned Features>
+  [[nodiscard]] bool denseBfsExplore(
+      std::unique_ptr<const rc::sol::IState> initialState) {
+    using namespace std;
+    using namespace rc::ent;
+
+    const IdsMask targetMask{*targetLeftBank->idsMask()};
+
+    // The fake empty move producing the initial state
+    const MovingEntities initialMove{scenarioDetails->entities, {},
+                                     scenarioDetails->createMovingEntitiesExt()};
+    DenseSearch<Features> ds{*this, *initialState, initialMove};
+    ds.reach(ds.nodeSlot(0ULL), ds.nodeTime(0ULL));
+    ++results->investigatedStates;
+
+    // Appends a successor which is not covered by the slots.
+    // Returns true if it is the target state
+    const auto addSuccessor = [&](const DenseBfsSuccessor& successor) {
+      ds.add(successor);
+      if (successor.leftBank == targetMask) {
+        // Found an optimal solution
+        steps = make_shared<Attempt>(*denseBfsChainedMoves(
+            ds.nodes, size(ds.nodes) - 1ULL, std::move(initialState)));
+        return true;
+      }
+
+      ds.reach(successor.slot, successor.time);
+      ++results->investigatedStates;
+      return false;
+    };
+
+    vector<const MovingConfigOption*> allowedMovingConfigs;
+    vector<vector<DenseBfsSuccessor>> chunksSuccessors;
+
+    // Traversal of all the states reached after `depth` moves
+    for (size_t levelStart{}, depth{}; levelStart < size(ds.nodes); ++depth) {
+      const size_t levelEnd{size(ds.nodes)}, levelSize{levelEnd - levelStart};
+
+      // Small levels don't deserve the cost of waking up the workers
+      const size_t workersCount{
+          min(size_t(threadsCount), levelSize / MinStatesPerBfsWorker)};
+      if (workersCount <= 1ULL) {
+        bool solved{};
+        for (size_t idx{levelStart}; !solved && idx < levelEnd; ++idx) {
+          denseUpdateResults(ds, idx, depth);
+          denseExpand(ds, idx, depth, SymTb, allowedMovingConfigs,
+                      [&](const DenseBfsSuccessor& successor) {
+                        return solved = addSuccessor(successor);
+                      });
+        }
+        if (solved)
+          return true;
+
+        levelStart = levelEnd;
+        continue;
+      }
+
+      // Like in `parallelBfsExplore`, the workers generate the successors not
+      // covered by the states before this level, for consecutive chunks of
+      // the level. Then those successors get filtered and appended in the
+      // order of their parents, exactly as above
+      const size_t chunkSize{max<size_t>(
+          MinStatesPerBfsWorker, levelSize / (workersCount * 8ULL))},
+          chunksCount{(levelSize + chunkSize - 1ULL) / chunkSize};
+      chunksSuccessors.resize(chunksCount);
+      atomic<size_t> nextChunk{};
+      vector<exception_ptr> failures(workersCount);
+      workersPool().run(workersCount, [&](size_t w) noexcept {
+        try {
+          rc::SymbolsTable st{SymTb};
+          vector<const MovingConfigOption*> cfgs;
+          for (size_t chunk{nextChunk++}; chunk < chunksCount;
+               chunk = nextChunk++) {
+            vector<DenseBfsSuccessor>& chunkSuccessors{
+                chunksSuccessors[chunk]};
+            chunkSuccessors.clear();
+            const size_t chunkStart{levelStart + chunk * chunkSize},
+                chunkEnd{min(chunkStart + chunkSize, levelEnd)};
+            for (size_t idx{chunkStart}; idx < chunkEnd; ++idx)
+              denseExpand(ds, idx, depth, st, cfgs,
+                          [&chunkSuccessors](const DenseBfsSuccessor& succ) {
+                            chunkSuccessors.push_back(succ);
+                            return false;
+                          });
+          }
+        } catch (...) {
+          failures[w] = current_exception();
+          nextChunk = chunksCount;  // lets the other workers stop early
+        }
+      });
+
+      for (const exception_ptr& failure : failures)
+        if (failure)
+          rethrow_exception(failure);
+
+      for (size_t chunk{}, idx{levelStart}; chunk < chunksCount; ++chunk) {
+        const vector<DenseBfsSuccessor>& chunkSuccessors{
+            chunksSuccessors[chunk]};
+        auto it{cbegin(chunkSuccessors)};
+        for (const size_t chunkEnd{min(idx + chunkSize, levelEnd)};
+             idx < chunkEnd; ++idx) {
+          denseUpdateResults(ds, idx, depth);
+          for (; it != cend(chunkSuccessors) && it->parent == idx; ++it)
+            if (!ds.covers(*it) && addSuccessor(*it))
+              return true;
+        }
+      }
+
+      levelStart = levelEnd;
+    }
+
+    return false;
+  }
+
+  /**
+  Examines ds.nodes[idx], reached after `depth` moves and just taken out of
+  the queue of `denseUniformCostExplore` or `denseAStarExplore`, like those
+  searches examine a state.
+  Sets `steps` when the node is the target state.
+
+  @return nothing when the node was covered meanwhile, otherwise true if it's
+  the target state
+  */
+  template <unsigned Features>
+  [[nodiscard]] std::optional<bool> denseExamine(
+      DenseSearch<Features>& ds,
+      size_t idx,
+      size_t depth,
+      std::unique_ptr<const rc::sol::IState>& initialState) {
+    using namespace std;
+
+    if (ds.coversNode(idx))
+      return nullopt;  // reached meanwhile by a path at least as good
+
+    if (ds.nodes[idx].leftBank == *targetLeftBank->idsMask()) {
+      // Found an optimal solution
+      steps = make_shared<Attempt>(
+          *denseBfsChainedMoves(ds.nodes, idx, std::move(initialState)));
+      return true;
+    }
+
+    denseUpdateResults(ds, idx, depth);
+    ds.reach(ds.nodeSlot(idx), ds.nodeTime(idx));
+    ++results->investigatedStates;
+    return false;
+  }
+
+  /// A node of `denseUniformCostExplore` waiting to be explored
+  struct DenseUcsEntry {
+    unsigned node;   ///< the index of the node
+    unsigned depth;  ///< the count of the moves leading to the node
+  };
+
+  /**
+  Same exploration as `uniformCostExplore` for the scenarios accepted by
+  `denseBfsFeatures`, which provide the `Features` of this instantiation.
+  Used only for time-aware states.
+  The states are kept in a `DenseSearch`, whose slots get reached when
+  the states are examined. The solution moves are rebuilt only at the end.
+
+  @return true if a solution was found
+  */
+  template <unsigned Features>
+  [[nodiscard]] bool denseUniformCostExplore(
+      std::unique_ptr<const rc::sol::IState> initialState) {
+    using namespace std;
+    using namespace rc::ent;
+
+    // The fake empty move producing the initial state
+    const MovingEntities initialMove{scenarioDetails->entities, {},
+                                     scenarioDetails->createMovingEntitiesExt()};
+    DenseSearch<Features> ds{*this, *initialState, initialMove};
+
+    vector<deque<DenseUcsEntry>> buckets(size_t(maxCrossingDuration()) +
+                                         1ULL);
+    const auto bucketFor =
+        [&buckets](unsigned time) noexcept -> deque<DenseUcsEntry>& {
+      return buckets[size_t(time) % size(buckets)];
+    };
+
+    unsigned crtTime{ds.nodeTime(0ULL)};
+    bucketFor(crtTime).push_back({0U, 0U});
+    size_t pendingNodes{1ULL};
+
+    vector<const MovingConfigOption*> allowedMovingConfigs;
+    for (; pendingNodes > 0ULL; ++crtTime) {
+      // Crossings lasting 0 time units append to this bucket while looping
+      deque<DenseUcsEntry>& bucket{bucketFor(crtTime)};
+      while (!bucket.empty()) {
+        const DenseUcsEntry entry{bucket.front()};
+        bucket.pop_front();
+        --pendingNodes;
+
+        const optional<bool> solved{
+            denseExamine(ds, entry.node, entry.depth, initialState)};
+        if (!solved)
+          continue;  // reached meanwhile at least as early
+        if (*solved)
+          return true;
+
+        denseExpand(ds, entry.node, entry.depth, SymTb, allowedMovingConfigs,
+                    [&](const DenseBfsSuccessor& successor) {
+                      assert(successor.time >= crtTime &&
+                             successor.time - crtTime < size(buckets));
+                      ds.add(successor);
+                      bucketFor(successor.time)
+                          .push_back({unsigned(size(ds.nodes) - 1ULL),
+                                      entry.depth + 1U});
+                      ++pendingNodes;
+                      return false;
+                    });
+      }
+    }
+
+    return false;
+  }
+
+  /**
+  Same exploration as `aStarExplore` for the scenarios accepted by
+  `denseBfsFeatures`, which provide the `Features` of this instantiation.
+  The states are kept in a `DenseSearch`, whose slots get reached when
+  the states are examined. The solution moves are rebuilt only at the end.
+
+  @return true if a solution was found
+  */
+  template <unsigned Features>
+  [[nodiscard]] bool denseAStarExplore(
+      std::unique_ptr<const rc::sol::IState> initialState) {
+    using namespace std;
+    using namespace rc::ent;
+
+    // The fake empty move producing the initial state
+    const MovingEntities initialMove{scenarioDetails->entities, {},
+                                     scenarioDetails->createMovingEntitiesExt()};
+    DenseSearch<Features> ds{*this, *initialState, initialMove};
+
+    // The entries refer the nodes by index
+    priority_queue<AStarEntry<unsigned>, vector<AStarEntry<unsigned>>,
+                   greater<>>
+        nodesToExplore;
+    size_t entriesCount{};
+    nodesToExplore.push(
+        {crossingsLowerBound(ds.nodes[0ULL].leftBank, true), 0ULL,
+         entriesCount++, 0U});
+
+    vector<const MovingConfigOption*> allowedMovingConfigs;
+    do {
+      const AStarEntry<unsigned> entry{nodesToExplore.top()};
+      nodesToExplore.pop();
+
+      const optional<bool> solved{
+          denseExamine(ds, entry.move, entry.crossings, initialState)};
+      if (!solved)
+        continue;  // reached meanwhile by a path at least as good
+      if (*solved)
+        return true;
+
+      denseExpand(ds, entry.move, entry.crossings, SymTb,
+                  allowedMovingConfigs,
+                  [&](const DenseBfsSuccessor& successor) {
+                    ds.add(successor);
+                    const size_t crossings{entry.crossings + 1ULL};
+                    nodesToExplore.push(
+                        {crossings + crossingsLowerBound(
+                                         successor.leftBank,
+                                         successor.nextMoveFromLeft),
+                         crossings, entriesCount++,
+                         unsigned(size(ds.nodes) - 1ULL)});
+                    return false;
+                  });
+    } while (!nodesToExplore.empty());
+
+    return false;
+  }
+
+  /**
+  @return the chained moves leading to nodes[lastIdx].
+  The states are obtained by replaying the moves from `initialState`, so they
+  get the same extensions as during `bfsExplore`
+  */
+  [[nodiscard]] std::shared_ptr<const ChainedMove> denseBfsChainedMoves(
+      const std::vector<DenseBfsNode>& nodes,
+      size_t lastIdx,
+      std::unique_ptr<const rc::sol::IState> initialState) const {
+    using namespace std;
+    using namespace rc::ent;
+
+    vector<size_t> path;
+    for (size_t idx{lastIdx}; idx != UINT_MAX; idx = nodes[idx].parent)
+      path.push_back(idx);
+
+    const shared_ptr<const AllEntities>& entities{scenarioDetails->entities};
+    shared_ptr<const ChainedMove> result{make_shared<const ChainedMove>(
+        MovingEntities(entities, {},
+                       scenarioDetails->createMovingEntitiesExt()),
+        std::move(initialState),
+        UINT_MAX)};  // UINT_MAX index required for the fake initial move
+
+    // path.back() is the initial state, already covered above
+    for (auto it = next(crbegin(path)); it != crend(path); ++it) {
+      const DenseBfsNode& node{nodes[*it]};
+      const MovingEntities& movingCfg{*node.movingCfg};
+      const unsigned moveIdx{1U + result->index()};  // wraps for UINT_MAX
+      unique_ptr<const rc::sol::IState> nextState{
+          result->resultedState()->next(movingCfg)};
+      assert(*nextState->leftBank().idsMask() == node.leftBank);
+      result = make_shared<const ChainedMove>(
+          movingCfgsManager.sharedConfig(movingCfg), std::move(nextState),
+          moveIdx, result);
+    }
+    return result;
+  }
+
+  /**
+  @return true if the moves of the scenario are reversible, so a bidirectional
+  BFS can be used. This happens when the states have no extensions
+  (see `denseBfsApplicable`) and when the validity of the raft/bridge
+  configurations doesn't depend on `CrossingIndex`, that is when all entities
+  either always or never row and the allowed loads don't depend on it.
+  Then moving some entities back leads to the previous state.
+  */
+  [[nodiscard]] bool bidirectionalBfsApplicable(
+      const rc::sol::IState& initialState) const noexcept {
+    using namespace std;
+
+    const rc::ent::AllEntities& entities{*scenarioDetails->entities};
+    if (!entities.masksAllowed() ||
+        !dynamic_pointer_cast<const rc::sol::DefStateExt>(
+            initialState.getExtension().get()))
+      return false;
+
+    for (const unsigned id : entities.ids())
+      if (boost::logic::indeterminate(entities[id]->canRow()))
+        return false;
+
+    return !scenarioDetails->allowedLoads ||
+           !scenarioDetails->allowedLoads->dependsOnVariable("CrossingIndex");
+  }
+
+  /// The states discovered by the bidirectional BFS in one direction
+  struct BidirectionalBfsSide {
+    std::vector<DenseBfsNode> nodes;  ///< the discovered states
+
+    /// Indices of the nodes by the direction of their next move and then by
+    /// their left bank
+    std::array<std::unordered_map<rc::ent::IdsMask, unsigned>, 2ULL> index;
+
+    size_t levelStart{};  ///< the first node from the last level
+    size_t depth{};       ///< the depth of the last level
+
+    /// @return the index of the node for the given state or UINT_MAX
+    [[nodiscard]] unsigned find(rc::ent::IdsMask leftBank,
+                                bool nextMoveFromLeft) const {
+      const auto& forDirection{index[nextMoveFromLeft ? 1ULL : 0ULL]};
+      const auto it = forDirection.find(leftBank);
+      return (it == cend(forDirection)) ? UINT_MAX : it->second;
+    }
+
+    /// Appends a node not discovered yet
+    void add(const DenseBfsNode& node) {
+      index[node.nextMoveFromLeft ? 1ULL : 0ULL].emplace(node.leftBank,
+                                                         (unsigned)size(nodes));
+      nodes.push_back(node);
+    }
+
+    /// @return the count of nodes from the last level
+    [[nodiscard]] size_t levelSize() const noexcept {
+      return size(nodes) - levelStart;
+    }
+  };
+
+  /**
+  BFS for scenarios accepted by `bidirectionalBfsApplicable`, expanding
+  alternately the states reached from the initial state and those reaching
+  the target state. Each step expands the entire last level of the side
+  with fewer states on that level. The paths get stitched when a state is
+  found on both sides.
+
+  Any path shorter than the found one would have produced an earlier
+  meeting, so the solution has fewest crossings, like in `bfsExplore`.
+  Since the moves are reversible, the predecessors of a state are obtained
+  just like its successors.
+
+  Only the states reached from the initial state are reported in the
+  statistics about the investigated paths.
+
+  @return true if a solution was found
+  */
+  [[nodiscard]] bool bidirectionalBfsExplore(
+      std::unique_ptr<const rc::sol::IState> initialState) {
+    using namespace std;
+    using namespace rc::ent;
+
+    const shared_ptr<const AllEntities>& entities{scenarioDetails->entities};
+    const IdsMask allMask{entities->fullMask()},
+        targetMask{*targetLeftBank->idsMask()};
+    const rc::cond::ConfigConstraints* banksConstraints{
+        scenarioDetails->banksConstraints.get()};
+    const auto validBanks = [&](IdsMask leftBank) {
+      return !banksConstraints ||
+             (banksConstraints->check(BankEntities{entities, leftBank}) &&
+              banksConstraints->check(
+                  BankEntities{entities, allMask & ~leftBank}));
+    };
+
+    // The fake empty move producing the states where the search starts
+    const MovingEntities noMove{entities, {},
+                                scenarioDetails->createMovingEntitiesExt()};
+
+    BidirectionalBfsSide forward, backward;
+    forward.add(
+        {*initialState->leftBank().idsMask(), &noMove, UINT_MAX, true});
+    ++results->investigatedStates;
+
+    // A last move from the right bank cannot leave the left bank empty,
+    // so an empty target left bank is reached only from the left bank
+    if (validBanks(targetMask)) {
+      backward.add({targetMask, &noMove, UINT_MAX, false});
+      ++results->investigatedStates;
+      if (targetMask) {
+        backward.add({targetMask, &noMove, UINT_MAX, true});
+        ++results->investigatedStates;
+      }
+    }
+
+    vector<const MovingConfigOption*> allowedMovingConfigs;
+    while (forward.levelSize() > 0ULL && backward.levelSize() > 0ULL) {
+      const bool expandForward{forward.levelSize() <= backward.levelSize()};
+      BidirectionalBfsSide &crtSide{expandForward ? forward : backward},
+          &otherSide{expandForward ? backward : forward};
+
+      const size_t levelEnd{size(crtSide.nodes)};
+      for (size_t idx{crtSide.levelStart}; idx < levelEnd; ++idx) {
+        // nodes might get reallocated below, so copying the node
+        const DenseBfsNode node{crtSide.nodes[idx]};
+        const BankEntities leftBank{entities, node.leftBank},
+            rightBank{entities, allMask & ~node.leftBank};
+        if (expandForward)
+          results->update(crtSide.depth,
+                          targetLeftBank->differencesCount(leftBank),
+                          leftBank, minDistToGoal);
+
+        movingCfgsManager.configsForBank(
+            node.nextMoveFromLeft ? leftBank : rightBank, allowedMovingConfigs,
+            node.nextMoveFromLeft);
+
+        for (const MovingConfigOption* cfgOption : allowedMovingConfigs) {
+          assert(cfgOption);
+          const MovingEntities* const movingCfg{&cfgOption->get()};
+          const IdsMask movedMask{*movingCfg->idsMask()};
+          const DenseBfsNode nextNode{
+              node.nextMoveFromLeft ? (node.leftBank & ~movedMask)
+                                    : (node.leftBank | movedMask),
+              movingCfg, (unsigned)idx, !node.nextMoveFromLeft};
+          if (crtSide.find(nextNode.leftBank, nextNode.nextMoveFromLeft) !=
+                  UINT_MAX ||
+              !validBanks(nextNode.leftBank))
+            continue;  // check next raft/bridge config
+
+          crtSide.add(nextNode);
+          ++results->investigatedStates;
+
+          const unsigned met{
+              otherSide.find(nextNode.leftBank, nextNode.nextMoveFromLeft)};
+          if (met != UINT_MAX) {
+            const unsigned last{(unsigned)size(crtSide.nodes) - 1U};
+            steps = make_shared<Attempt>(*bidirectionalBfsChainedMoves(
+                forward.nodes, expandForward ? last : met, backward.nodes,
+                expandForward ? met : last, std::move(initialState)));
+            return true;
+          }
+        }
+      }
+
+      crtSide.levelStart = levelEnd;
+      ++crtSide.depth;
+    }
+
+    return false;
+  }
+
+  /**
+  @return the chained moves leading to forwardNodes[forwardIdx], followed by
+  those leading from backwardNodes[backwardIdx] (the same state) to the
+  target state
+  */
+  [[nodiscard]] std::shared_ptr<const ChainedMove> bidirectionalBfsChainedMoves(
+      const std::vector<DenseBfsNode>& forwardNodes,
+      size_t forwardIdx,
+      const std::vector<DenseBfsNode>& backwardNodes,
+      size_t backwardIdx,
+      std::unique_ptr<const rc::sol::IState> initialState) const {
+    using namespace std;
+    using namespace rc::ent;
+
+    shared_ptr<const ChainedMove> result{denseBfsChainedMoves(
+        forwardNodes, forwardIdx, std::move(initialState))};
+
+    // Each backward node was produced by moving its `movingCfg` from its
+    // parent, so moving it back leads to the parent
+    const shared_ptr<const AllEntities>& entities{scenarioDetails->entities};
+    const IdsMask allMask{entities->fullMask()};
+    for (size_t idx{backwardIdx}; backwardNodes[idx].parent != UINT_MAX;
+         idx = backwardNodes[idx].parent) {
+      const MovingEntities& movingCfg{*backwardNodes[idx].movingCfg};
+      const DenseBfsNode& parent{backwardNodes[backwardNodes[idx].parent]};
+      result = make_shared<const ChainedMove>(
+          movingCfgsManager.sharedConfig(movingCfg),
+          make_unique<const State>(
+              BankEntities{entities, parent.leftBank},
+              BankEntities{entities, allMask & ~parent.leftBank},
+              parent.nextMoveFromLeft, rc::sol::DefStateExt::SHARED_INST()),
+          1U + result->index(),  // wraps around for UINT_MAX
+          result);
+    }
+    return result;
+  }
+
+  /// A move from the current path of the iterative DFS, together with the
+  /// raft/bridge configurations allowed after it
+  struct DfsFrame {
+    /// The raft/bridge configurations allowed after the move of the frame
+    std::vector<const MovingConfigOption*> allowedCfgs;
+
+    size_t nextCfgIdx{};  ///< the index of the next configuration to try
+  };
+
+  /**
+  The iterative DFS of the subtree of a state. The sequential DFS is a single
+  task starting from the initial state, while `parallelDfsExplore` splits
+  its busy tasks for the idle workers.
+
+  Only its worker changes the task, except for the allowed configurations of
+  its frames, which other workers might take over. So the worker needs `mutex`
+  for changing `steps` or `frames`, but not for reading `steps`.
+  */
+  struct DfsTask {
+    DfsTask(std::shared_ptr<Attempt> steps_, const rc::SymbolsTable& SymTb_)
+        : steps{std::move(steps_)},
+          SymTb{SymTb_},
+          firstFrameLength{steps->length()} {}
+
+    /// The current path, whose first `firstFrameLength` moves were explored
+    /// by the task which was split to provide this one
+    std::shared_ptr<Attempt> steps;
+
+    rc::SymbolsTable SymTb;  ///< the Symbols Table of the task
+
+    /// frames[i] is the frame of the state reached after the first
+    /// `firstFrameLength + i` moves from `steps`
+    std::vector<DfsFrame> frames;
+
+    size_t firstFrameLength;  ///< the length of `steps` for frames[0]
+
+    /// The statistics of the task, merged into `results` by its worker
+    rc::Scenario::Results stats{};
+
+    /// Like `Solver::minDistToGoal`, but only for the task
+    size_t minDistToGoal{SIZE_MAX};
+
+    /// Protects `steps` and `frames` from the workers splitting the task
+    std::mutex mutex;
+  };
+
+  /// Outcome of `dfsProbe`
+  enum class DfsProgress {
+    Solved,      ///< `steps` contains a solution
+    Exhausted,   ///< there is no solution
+    OutOfProbes  ///< the probes budget got spent before any of the above
+  };
+
+  /// @return the fake move producing `initialState`, which starts the DFS
+  [[nodiscard]] Move dfsInitialMove(
+      std::unique_ptr<const rc::sol::IState> initialState) const {
+    return Move(
+        rc::ent::MovingEntities{scenarioDetails->entities,
+                                {},
+                                scenarioDetails->createMovingEntitiesExt()},
+        std::move(initialState),
+        UINT_MAX);  // UINT_MAX index required for the fake initial move
+  }
+
+  /**
+  Starts the sequential DFS as a task entering the fake move producing the
+  initial state. `dfsProbe` performs then the actual search
+  */
+  void dfsStart(std::unique_ptr<const rc::sol::IState> initialState) {
+    dfsMain = std::make_unique<DfsTask>(std::make_shared<Attempt>(), SymTb);
+    steps = dfsMain->steps;
+
+    // The fake initial move cannot reach the solution
+    ignore = dfsEnter(*dfsMain, dfsInitialMove(std::move(initialState)));
+  }
+
+  /**
+  Runs the DFS started by `dfsStart` for a budget of at most `maxProbes`
+  raft/bridge configurations and adds its statistics to `results`.
+  `dfsExplore` uses this to stop the DFS once `maxDfsProbes` gets spent.
+
+  The frames remain after spending the budget, so a new call with another
+  budget continues the same search, like `resumeDfs` does. `saveDfs` and
+  `loadDfs` allow continuing it within another process.
+
+  @return whether the search found a solution, found there is none or spent
+  its budget
+  */
+  [[nodiscard]] DfsProgress dfsProbe(size_t maxProbes = SIZE_MAX) {
+    const DfsProgress progress{dfsProbe(*dfsMain, maxProbes)};
+    mergeDfsTaskStats(*dfsMain);
+    dfsMain->stats = {};
+    return progress;
+  }
+
+  /**
+  Marks the state as examined, unless it was examined already, possibly by
+  another task of `parallelDfsExplore`.
+
+  @return true if the state wasn't examined before
+  */
+  [[nodiscard]] bool dfsExamine(
+      const std::shared_ptr<const rc::sol::IState>& s) {
+    if (sharedExaminedStates)
+      return sharedExaminedStates->addIfNotCovered(s);
+
+    if (examinedStates.cover(*s))
+      return false;
+
+    examinedStates.add(s);
+    return true;
+  }
+
+  /**
+  Appends `move` to the path of the task and, unless it reaches the solution
+  or an examined state, pushes the frame for exploring the successors of the
+  reached state. Updates the statistics and the Symbols Table of the task for
+  the newly examined state.
+
+  @return true if the move reaches the solution
+  */
+  [[nodiscard]] bool dfsEnter(DfsTask& task, const Move& move) {
+    using namespace std;
+
+    {
+      const lock_guard lock{task.mutex};
+      task.steps->append(move);
+      if (task.steps->isSolution())
+        return true;
+
+      if (!dfsExamine(move.resultedState())) {
+        task.steps->pop();
+        return false;
+      }
+    }
+
+    const rc::sol::IState& s{*move.resultedState()};
+    ++task.stats.investigatedStates;
+    task.stats.update(size_t(move.index() + 1U),  // wraps around for UINT_MAX
+                      targetLeftBank->differencesCount(s.leftBank()),
+                      s.leftBank(), task.minDistToGoal);
+
+    // Same SymTb updates as in `commonTasksAddMove`
+    task.SymTb[CrossingIndexSlot] = double(move.index() + 2U);
+    move.movedEntities().getExtension()->addMovePostProcessing(task.SymTb);
+
+    DfsFrame frame;
+    allowedMovingConfigurations(s, frame.allowedCfgs, task.SymTb);
+    const bool splittable{!frame.allowedCfgs.empty()};
+
+    {
+      const lock_guard lock{task.mutex};
+      task.frames.push_back(std::move(frame));
+    }
+
+    // Idle workers of `parallelDfsExplore` might split the new frame
+    if (splittable && dfsIdleWorkers)
+      dfsNotifyIdle();
+    return false;
+  }
+
+  /// Drops the last frame of the task and reverts the move leading to it
+  void dfsLeave(DfsTask& task) {
+    {
+      const std::lock_guard lock{task.mutex};
+      task.frames.pop_back();
+      if (task.frames.empty())
+        return;  // the task is over
+
+      task.steps->pop();
+    }
+
+    --task.SymTb[CrossingIndexSlot];
+
+    // Allowing the actions of the extensions
+    const gsl::not_null<const rc::ent::IMovingEntitiesExt*> previousMoveExt{
+        task.steps->lastMove().movedEntities().getExtension()};
+    previousMoveExt->removeMovePostProcessing(task.SymTb);
+  }
+
+  /**
+  Continues the task, probing at most `maxProbes` raft/bridge configurations.
+
+  The path is explored with an explicit stack of frames instead of recursion,
+  so its length isn't limited by the native stack.
+  A cancelled task of `parallelDfsExplore` stops as if it were exhausted.
+
+  @return whether the task found a solution, found there is none or spent its
+  budget
+  */
+  [[nodiscard]] DfsProgress dfsProbe(DfsTask& task, size_t maxProbes) {
+    using namespace std;
+    using namespace rc::ent;
+    using namespace rc::sol;
+
+    while (!dfsCancelled) {
+      const MovingConfigOption* cfgOption{};
+      {
+        const lock_guard lock{task.mutex};
+        if (task.frames.empty())
+          break;
+
+        DfsFrame& frame{task.frames.back()};
+        if (frame.nextCfgIdx < size(frame.allowedCfgs)) {
+          if (!maxProbes)
+            return DfsProgress::OutOfProbes;
+          cfgOption = frame.allowedCfgs[frame.nextCfgIdx++];
+        }
+      }
+
+      if (!cfgOption) {
+        dfsLeave(task);  // Dead end => backtracking
+        continue;
+      }
+      --maxProbes;
+
+      const MovingEntities* const movingCfg{&cfgOption->get()};
+      const shared_ptr<const IState> crtState{
+          task.steps->lastMove().resultedState()};
+      unique_ptr<const IState> nextState{crtState->next(*movingCfg)};
+
+#ifndef NDEBUG
+      if (!sharedExaminedStates)  // the parallel tasks would mix their output
+        cout << "\nSimulating move " << *movingCfg << " => " << *nextState
+             << endl;
+#endif  // NDEBUG
+
+      if (!nextState->valid(scenarioDetails->banksConstraints.get()))
+        continue;  // check next raft/bridge config
+
+      if (dfsEnter(task, Move(cfgOption->shared(), std::move(nextState),
+                              (unsigned)task.steps->length())))
+        return DfsProgress::Solved;
+    }
+
+    return DfsProgress::Exhausted;
+  }
+
+  /**
+  @return true if a solution was found using the iterative DFS within
+  `maxDfsProbes` probes. Marks the results as interrupted when the search
+  stopped because of this budget
+  */
+  [[nodiscard]] bool dfsExplore(
+      std::unique_ptr<const rc::sol::IState> initialState) {
+    dfsStart(std::move(initialState));
+    const DfsProgress progress{dfsProbe(maxDfsProbes)};
+    results->interrupted = progress == DfsProgress::OutOfProbes;
+    return progress == DfsProgress::Solved;
+  }
+
+  /**
+  Lower bound for the count of crossings still needed after reaching state `s`.
+  It is the optimal count for a relaxed puzzle without any constraints except:
+  - each crossing moves between `minMoved` and `maxMoved` entities
+  (see `MovingConfigsManager::configsSizesRange`)
+  - each crossing changes the bank of at most `maxMoved` misplaced entities
+
+  Thus the bound is admissible and consistent (it decreases by at most 1 after
+  each move), so `aStarExplore` finds solutions with fewest crossings.
+  */
+  [[nodiscard]] size_t crossingsLowerBound(
+      const rc::sol::IState& s) const noexcept {
+    return crossingsLowerBound(targetLeftBank->differencesCount(s.leftBank()),
+                               s.leftBank().count(), s.nextMoveFromLeft());
+  }
+
+  /// Same as the overload above for the state with the entities from
+  /// `leftMask` on the left bank
+  [[nodiscard]] size_t crossingsLowerBound(
+      rc::ent::IdsMask leftMask,
+      bool nextMoveFromLeft) const noexcept {
+    return crossingsLowerBound(
+        (size_t)std::popcount(leftMask ^ *targetLeftBank->idsMask()),
+        (size_t)std::popcount(leftMask), nextMoveFromLeft);
+  }
+
+  /// Same as the overloads above for a state with `misplaced` entities and
+  /// with `leftCount` entities on the left bank
+  [[nodiscard]] size_t crossingsLowerBound(
+      size_t misplaced,
+      size_t leftCount,
+      bool nextMoveFromLeft) const noexcept {
+    using namespace std;
+
+    if (!misplaced)
+      return 0ULL;
+
+    const auto [minMoved, maxMoved] = movingCfgsManager.configsSizesRange();
+
+    // How many entities have to leave the bank where the raft/bridge is now.
+    // A negative value means that bank has to receive entities
+    const ptrdiff_t leftSurplus{ptrdiff_t(leftCount) -
+                                ptrdiff_t(targetLeftBank->count())};
+    const ptrdiff_t surplus{nextMoveFromLeft ? leftSurplus : -leftSurplus};
+
+    // A relaxed solution needs at most (2 * entities + 1) crossings
+    // when it exists. Otherwise the puzzle is unsolvable from the state,
+    // so any bound is fine
+    const size_t maxCrossings{2ULL * scenarioDetails->entities->count() + 2ULL};
+    for (size_t crossings{1ULL}; crossings < maxCrossings; ++crossings) {
+      if (misplaced > crossings * maxMoved)
+        continue;
+
+      // Departures from the current bank and the returns to it
+      const ptrdiff_t departures{ptrdiff_t((crossings + 1ULL) / 2ULL)},
+          returns{ptrdiff_t(crossings / 2ULL)};
+      if (surplus >= departures * ptrdiff_t(minMoved) -
+                         returns * ptrdiff_t(maxMoved) &&
+          surplus <= departures * ptrdiff_t(maxMoved) -
+                         returns * ptrdiff_t(minMoved))
+        return crossings;
+    }
+    return maxCrossings;
+  }
+
+  /**
+  A move waiting to be explored by `aStarExplore`, or by `denseAStarExplore`,
+  which refers the move through the index of the node it produces
+  */
+  template <class Move>
+  struct AStarEntry {
+    /// Crossings count of the move plus the lower bound of the remaining ones
+    size_t estimatedCrossings;
+
+    size_t crossings;  ///< count of the crossings up to the move, inclusive
+    size_t order;      ///< the count of entries created before this one
+
+    Move move;  ///< the move to explore
+
+    /// Orders the entries from the most to the least promising
+    [[nodiscard]] bool operator>(const AStarEntry& other) const noexcept {
+      if (estimatedCrossings != other.estimatedCrossings)
+        return estimatedCrossings > other.estimatedCrossings;
+
+      // Among equally promising entries, the ones closer to the goal
+      if (crossings != other.crossings)
+        return crossings < other.crossings;
+
+      return order > other.order;  // first in, first out
+    }
+  };
+
+  /**
+  A* exploration using `crossingsLowerBound`.
+  Like `bfsExplore`, it finds solutions with fewest crossings, but it usually
+  investigates fewer states.
+
+  A state is examined only when it gets out of the priority queue, as it might
+  be reached first through a longer path. Its statistics are updated then,
+  too.
+
+  @return true if a solution was found
+  */
+  [[nodiscard]] bool aStarExplore(
+      std::unique_ptr<const rc::sol::IState> initialState) {
+    using namespace std;
+    using namespace rc::ent;
+    using namespace rc::sol;
+
+    using Entry = AStarEntry<shared_ptr<const ChainedMove>>;
+    priority_queue<Entry, vector<Entry>, greater<>> movesToExplore;
+    size_t entriesCount{};
+
+    // The initial entry is the fake move producing initial state
+    const size_t initialBound{crossingsLowerBound(*initialState)};
+    movesToExplore.push(
+        {initialBound, 0ULL, entriesCount++,
+         make_shared<const ChainedMove>(
+             MovingEntities(scenarioDetails->entities, {},
+                            scenarioDetails->createMovingEntitiesExt()),
+             std::move(initialState),
+             UINT_MAX)});  // UINT_MAX index required for the fake initial move
+
+    assert(!initialState);  // moved to movesToExplore
+
+    vector<const MovingConfigOption*> allowedMovingConfigs;
+    do {
+      const Entry entry{movesToExplore.top()};
+      movesToExplore.pop();
+
+      const shared_ptr<const IState> crtState{entry.move->resultedState()};
+      if (examinedStates.cover(*crtState))
+        continue;  // reached meanwhile by a path at least as good
+
+#ifndef NDEBUG
+      cout << "\nDiscovering successors of move:\n" << *entry.move << endl;
+#endif  // NDEBUG
+
+      if (crtState->leftBank() == *targetLeftBank) {
+        // Found an optimal solution
+        steps = make_shared<Attempt>(*entry.move);
+        return true;
+      }
+
+      commonTasksAddMove(*entry.move);
+      addExaminedState(crtState);
+
+      allowedMovingConfigurations(*crtState, allowedMovingConfigs);
+      for (const MovingConfigOption* cfgOption : allowedMovingConfigs) {
+        assert(cfgOption);
+        const MovingEntities* const movingCfg{&cfgOption->get()};
+        unique_ptr<const IState> nextState{crtState->next(*movingCfg)};
+
+#ifndef NDEBUG
+        cout << "\nProbing move " << *movingCfg << " => " << *nextState << endl;
+#endif  // NDEBUG
+
+        if (!nextState->valid(scenarioDetails->banksConstraints.get()) ||
+            examinedStates.cover(*nextState))
+          continue;  // check next raft/bridge config
+
+        const size_t crossings{entry.crossings + 1ULL},
+            estimate{crossings + crossingsLowerBound(*nextState)};
+        movesToExplore.push(
+            {estimate, crossings, entriesCount++,
+             make_shared<const ChainedMove>(
+                 cfgOption->shared(),
+                 std::move(nextState),
+                 1U + entry.move->index(),  // wraps around for UINT_MAX
+                 entry.move)});
+      }
+    } while (!movesToExplore.empty());
+
+    return false;
+  }
+
+  /// @return the moment when state `s` is reached
+  [[nodiscard]] static unsigned timeOf(const rc::sol::IState& s) noexcept {
+    return rc::sol::AbsStateExt::selectExt<rc::sol::TimeStateExt>(
+               s.getExtension().get())
+        ->time();
+  }
+
+  /// @return the duration of the longest crossing
+  [[nodiscard]] unsigned maxCrossingDuration() const noexcept {
+    unsigned result{};
+    for (const rc::cond::ConfigurationsTransferDuration& ctdItem :
+         scenarioDetails->ctdItems)
+      result = std::max(result, ctdItem.duration());
+    return result;
+  }
+
+  /**
+  Uniform-cost search ordered by `TimeStateExt::time()`, for scenarios with
+  crossing durations. Finds the solutions taking the least time.
+
+  Every crossing lasts at most `maxCrossingDuration` time units, so a circular
+  array of (maxCrossingDuration + 1) buckets, one for each moment, is enough
+  for the moves waiting to be explored (Dial's algorithm). The buckets are
+  visited in increasing order of their moment.
+
+  A state is examined only when it gets out of its bucket, like in
+  `aStarExplore`. Since the states are examined in the order of their time,
+  `examinedStates` then prunes the later states dominated by them
+  (see `TimeStateExt::_isNotBetterThan`).
+
+  @return true if a solution was found
+  */
+  [[nodiscard]] bool uniformCostExplore(
+      std::unique_ptr<const rc::sol::IState> initialState) {
+    using namespace std;
+    using namespace rc::ent;
+    using namespace rc::sol;
+
+    vector<deque<shared_ptr<const ChainedMove>>> buckets(
+        size_t(maxCrossingDuration()) + 1ULL);
+    const auto bucketFor = [&buckets](unsigned time) noexcept
+        -> deque<shared_ptr<const ChainedMove>>& {
+      return buckets[size_t(time) % size(buckets)];
+    };
+
+    // The initial entry is the fake move producing initial state
+    unsigned crtTime{timeOf(*initialState)};
+    bucketFor(crtTime).push_back(make_shared<const ChainedMove>(
+        MovingEntities(scenarioDetails->entities, {},
+                       scenarioDetails->createMovingEntitiesExt()),
+        std::move(initialState),
+        UINT_MAX));  // UINT_MAX index required for the fake initial move
+    size_t pendingMoves{1ULL};
+
+    assert(!initialState);  // moved to the bucket of the initial moment
+
+    vector<const MovingConfigOption*> allowedMovingConfigs;
+    for (; pendingMoves > 0ULL; ++crtTime) {
+      // Crossings lasting 0 time units append to this bucket while looping
+      deque<shared_ptr<const ChainedMove>>& bucket{bucketFor(crtTime)};
+      while (!bucket.empty()) {
+        const shared_ptr<const ChainedMove> move{std::move(bucket.front())};
+        bucket.pop_front();
+        --pendingMoves;
+
+        const shared_ptr<const IState> crtState{move->resultedState()};
+        if (examinedStates.cover(*crtState))
+          continue;  // reached meanwhile at least as early
+
+#ifndef NDEBUG
+        cout << "\nDiscovering successors of move:\n" << *move << endl;
+#endif  // NDEBUG
+
+        if (crtState->leftBank() == *targetLeftBank) {
+          // Found a solution taking the least time
+          steps = make_shared<Attempt>(*move);
+          return true;
+        }
+
+        commonTasksAddMove(*move);
+        addExaminedState(crtState);
+
+        allowedMovingConfigurations(*crtState, allowedMovingConfigs);
+        for (const MovingConfigOption* cfgOption : allowedMovingConfigs) {
+          assert(cfgOption);
+          const MovingEntities* const movingCfg{&cfgOption->get()};
+          unique_ptr<const IState> nextState{crtState->next(*movingCfg)};
+
+#ifndef NDEBUG
+          cout << "\nProbing move " << *movingCfg << " => " << *nextState
+               << endl;
+#endif  // NDEBUG
+
+          if (!nextState->valid(scenarioDetails->banksConstraints.get()) ||
+              examinedStates.cover(*nextState))
+            continue;  // check next raft/bridge config
+
+          const unsigned nextTime{timeOf(*nextState)};
+          assert(nextTime >= crtTime && nextTime - crtTime < size(buckets));
+          bucketFor(nextTime).push_back(make_shared<const ChainedMove>(
+              cfgOption->shared(), std::move(nextState),
+              1U + move->index(),  // wraps around for UINT_MAX
+              move));
+          ++pendingMoves;
+        }
+      }
+    }
+
+    return false;
+  }
+
+  /**
+  DFS exploring in parallel, for `threadsCount` threads, the subtrees of
+  several states.
+
+  A single task starts from the initial state. Any idle worker splits a busy
+  task: it takes over about half of the configurations not tried yet from
+  the shallowest frame of such a task (see `dfsSplitBusyTask`). So the
+  workers share even a single deep subtree. Each task is explored with the
+  frames of `dfsProbe`, on the heap, and has its own Symbols Table and
+  attempt.
+
+  The examined states go to the shared `StripedExaminedStates`, whose stripes
+  have separate locks. Each task gathers its own statistics and merges them
+  into `results` when it ends, which is the only time it takes
+  `resultsMutex`. The first found solution cancels the remaining tasks.
+
+  The found solution might differ between runs, like the statistics.
+
+  @return true if a solution was found
+  */
+  [[nodiscard]] bool parallelDfsExplore(
+      std::unique_ptr<const rc::sol::IState> initialState) {
+    using namespace std;
+
+    sharedExaminedStates = make_unique<StripedExaminedStates>(interchangeable);
+    dfsCancelled = false;
+    steps.reset();
+
+    auto root{make_unique<DfsTask>(make_shared<Attempt>(), SymTb)};
+
+    // The fake initial move cannot reach the solution
+    ignore = dfsEnter(*root, dfsInitialMove(std::move(initialState)));
+    dfsRootSymTb = root->SymTb;
+
+    dfsActiveTasks.assign(1ULL, root.get());
+    dfsBusyWorkers = dfsMostBusyWorkers = 1U;  // the one exploring the root
+
+    vector<exception_ptr> failures(threadsCount);
+    workersPool().run(threadsCount, [&](size_t w) noexcept {
+      try {
+        dfsWork(w ? nullptr : std::move(root));
+      } catch (...) {
+        failures[w] = current_exception();
+        dfsCancelled = true;
+        dfsNotifyIdle();
+      }
+    });
+    sharedExaminedStates.reset();
+    dfsActiveTasks.clear();
+
+    for (const exception_ptr& failure : failures)
+      if (failure)
+        rethrow_exception(failure);
+
+    if (steps)
+      return true;
+
+    steps = make_shared<Attempt>();
+    return false;
+  }
+
+  /**
+  Explores the provided task, if any, and then the tasks split from the busy
+  ones, until no task remains or the search gets cancelled.
+  Without a task to split, the worker sleeps until `dfsNotifyIdle`.
+  A provided task must be among `dfsActiveTasks` and counted by
+  `dfsBusyWorkers`, like the tasks from `dfsSplitBusyTask`.
+  */
+  void dfsWork(std::unique_ptr<DfsTask> task) {
+    using namespace std;
+
+    for (;;) {
+      if (!task) {
+        // Counted as idle before reading `dfsSignal`, so a busy task either
+        // notifies after this, or its new frame is visible to the split
+        ++dfsIdleWorkers;
+        const unsigned signal{dfsSignal};
+        task = dfsSplitBusyTask();
+        if (!task) {
+          if (!dfsBusyWorkers || dfsCancelled) {
+            --dfsIdleWorkers;
+            return;
+          }
+
+          dfsSignal.wait(signal);  // until a task gets split, grows or ends
+          --dfsIdleWorkers;
+          continue;
+        }
+        --dfsIdleWorkers;
+      }
+
+      DfsProgress progress{DfsProgress::Exhausted};
+      exception_ptr failure;
+      try {
+        progress = dfsProbe(*task, SIZE_MAX);
+      } catch (...) {
+        failure = current_exception();
+      }
+
+      {
+        const lock_guard lock{dfsTasksMutex};
+        erase(dfsActiveTasks, task.get());
+      }
+
+      {
+        const lock_guard lock{resultsMutex};
+        mergeDfsTaskStats(*task);
+        if (progress == DfsProgress::Solved && !dfsCancelled) {
+          steps = task->steps;
+          dfsCancelled = true;
+        }
+      }
+
+      task.reset();
+      --dfsBusyWorkers;
+      dfsNotifyIdle();  // the search might be over
+
+      if (failure)
+        rethrow_exception(failure);
+    }
+  }
+
+  /// Wakes the idle workers of `parallelDfsExplore`, which wait for a change
+  /// of `dfsSignal`
+  void dfsNotifyIdle() noexcept {
+    ++dfsSignal;
+    dfsSignal.notify_all();
+  }
+
+  /// @return the index of the shallowest frame of the task with untried
+  /// configurations or SIZE_MAX if there is none. Needs the lock of the task
+  [[nodiscard]] static size_t dfsSplittableFrame(
+      const DfsTask& task) noexcept {
+    for (size_t i{}; i < size(task.frames); ++i)
+      if (task.frames[i].nextCfgIdx < size(task.frames[i].allowedCfgs))
+        return i;
+    return SIZE_MAX;
+  }
+
+  /**
+  Moves into a new task about half of the untried configurations of the
+  shallowest such frame among the busy tasks. The shallower the frame, the
+  larger the subtrees of those configurations are expected to be.
+
+  The new task copies the path leading to that frame and rebuilds its
+  Symbols Table from `dfsRootSymTb` by replaying the moves of the path.
+
+  @return the new task, already among `dfsActiveTasks` and counted by
+  `dfsBusyWorkers`, or nullptr when no task could be split
+  */
+  [[nodiscard]] std::unique_ptr<DfsTask> dfsSplitBusyTask() {
+    using namespace std;
+
+    const lock_guard tasksLock{dfsTasksMutex};
+
+    // Busy tasks which are changing their frames right now are skipped
+    DfsTask* victim{};
+    size_t shallowest{SIZE_MAX};
+    for (DfsTask* task : dfsActiveTasks) {
+      const unique_lock lock{task->mutex, try_to_lock};
+      if (!lock)
+        continue;
+
+      const size_t frameIdx{dfsSplittableFrame(*task)};
+      if (frameIdx != SIZE_MAX &&
+          task->firstFrameLength + frameIdx < shallowest) {
+        shallowest = task->firstFrameLength + frameIdx;
+        victim = task;
+      }
+    }
+    if (!victim)
+      return nullptr;
+
+    const lock_guard lock{victim->mutex};
+    const size_t frameIdx{dfsSplittableFrame(*victim)};  // might have changed
+    if (frameIdx == SIZE_MAX)
+      return nullptr;
+
+    const size_t pathLength{victim->firstFrameLength + frameIdx};
+    auto split{make_unique<DfsTask>(
+        make_shared<Attempt>(*victim->steps, pathLength), dfsRootSymTb)};
+    for (size_t i{}; i < pathLength; ++i) {
+      // Same SymTb updates as in `commonTasksAddMove`
+      const rc::sol::IMove& move{split->steps->move(i)};
+      split->SymTb[CrossingIndexSlot] = double(move.index() + 2U);
+      move.movedEntities().getExtension()->addMovePostProcessing(
+          split->SymTb);
+    }
+
+    // The victim keeps the first half of the untried configurations
+    DfsFrame& frame{victim->frames[frameIdx]};
+    const auto splitPos{
+        cbegin(frame.allowedCfgs) + ptrdiff_t(frame.nextCfgIdx) +
+        ptrdiff_t(size(frame.allowedCfgs) - frame.nextCfgIdx) / 2};
+    split->frames.emplace_back().allowedCfgs.assign(splitPos,
+                                                    cend(frame.allowedCfgs));
+    frame.allowedCfgs.erase(splitPos, cend(frame.allowedCfgs));
+
+    dfsActiveTasks.push_back(split.get());
+    if (dfsIdleWorkers)
+      dfsNotifyIdle();  // the new task might be split as well
+    const unsigned busyWorkers{++dfsBusyWorkers};
+    unsigned mostBusy{dfsMostBusyWorkers};
+    while (busyWorkers > mostBusy &&
+           !dfsMostBusyWorkers.compare_exchange_weak(mostBusy, busyWorkers)) {
+    }
+
+    return split;
+  }
+
+  /// Adds the statistics of the task to `results`. Needs `resultsMutex`
+  /// during `parallelDfsExplore`
+  void mergeDfsTaskStats(const DfsTask& task) {
+    results->investigatedStates += task.stats.investigatedStates;
+    results->longestInvestigatedPath = std::max(
+        results->longestInvestigatedPath, task.stats.longestInvestigatedPath);
+
+    if (task.minDistToGoal < minDistToGoal) {
+      minDistToGoal = task.minDistToGoal;
+      results->closestToTargetLeftBank = task.stats.closestToTargetLeftBank;
+
+    } else if (task.minDistToGoal == minDistToGoal) {
+      results->closestToTargetLeftBank.insert(
+          std::end(results->closestToTargetLeftBank),
+          std::cbegin(task.stats.closestToTargetLeftBank),
+          std::cend(task.stats.closestToTargetLeftBank));
+    }
+  }
+
+  /// The details of the scenario
+  gsl::not_null<const rc::ScenarioDetails*> scenarioDetails;
+
+  /// The results for the scenario
+  gsl::not_null<rc::Scenario::Results*> results;
+
+  rc::SymbolsTable SymTb;  ///< the Symbols Table
+
+  /// Provides the possible raft configurations for a new move
+  MovingConfigsManager movingCfgsManager;
+
+  /// The groups of entities that can swap places without consequences
+  InterchangeableEntities interchangeable;
+
+  /// Ensures the algorithm doesn't retry a path twice
+  ExaminedStates examinedStates;
+
+  /// How many threads can explore the states in parallel
+  unsigned threadsCount;
+
+  /// How many raft/bridge configurations the DFS may probe before giving up
+  size_t maxDfsProbes;
+
+  /// The threads of the parallel searches. Created by `workersPool`
+  std::unique_ptr<WorkersPool> workers;
+
+  /// The states examined by the tasks of `parallelDfsExplore`
+  std::unique_ptr<StripedExaminedStates> sharedExaminedStates;
+
+  /// The tasks of `parallelDfsExplore` being explored right now
+  std::vector<DfsTask*> dfsActiveTasks;
+
+  /// Protects `dfsActiveTasks`. Taken before the lock of any task
+  std::mutex dfsTasksMutex;
+
+  /// The Symbols Table after the initial fake move of `parallelDfsExplore`
+  rc::SymbolsTable dfsRootSymTb;
+
+  /// Protects `results`, `minDistToGoal` and `steps` when the tasks of
+  /// `parallelDfsExplore` end
+  std::mutex resultsMutex;
+
+  /// Count of the workers exploring tasks of `parallelDfsExplore` right now
+  std::atomic<unsigned> dfsBusyWorkers{};
+
+  /// Most workers ever exploring tasks simultaneously during the last
+  /// `parallelDfsExplore`
+  std::atomic<unsigned> dfsMostBusyWorkers{};
+
+  /// Set when the tasks of `parallelDfsExplore` need to stop
+  std::atomic<bool> dfsCancelled{};
+
+  /// Count of the workers of `parallelDfsExplore` waiting for a task to split
+  std::atomic<unsigned> dfsIdleWorkers{};
+
+  /// Changes when the idle workers of `parallelDfsExplore` might find a task
+  /// to split or might need to stop. See `dfsNotifyIdle`
+  std::atomic<unsigned> dfsSignal{};
+
+  /// The current evolution of the algorithm
+  std::shared_ptr<rc::sol::IAttempt> steps;
+
+  /// The task of the sequential DFS
+  std::unique_ptr<DfsTask> dfsMain;
 
   std::unique_ptr<const rc::ent::BankEntities> targetLeftBank;
 
@@ -13,13 +13,174 @@
 #ifndef H_SYMBOLS_TABLE
 #define H_SYMBOLS_TABLE
 
+#include "util.h"
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <map>
+#include <optional>
+#include <stdexcept>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <utility>
 
 namespace rc {
 
-/// Type of the symbols table - numeric values associated to string keys
-using SymbolsTable = std::unordered_map<std::string, double>;
+/**
+The symbols table - numeric values associated to variable names.
+
+The well-known variables `CrossingIndex` and `PreviousRaftLoad` have fixed
+slots. Their values are kept in a flat array indexed by these slots, so
+evaluating them or updating them during the search involves no string
+hashing. Any other variable is kept by its name, only within the table
+which received it.
+*/
+class SymbolsTable {
+ public:
+  /// Slot of `CrossingIndex` - the 1-based index of the crossing moves
+  static constexpr unsigned CrossingIndexSlot{0U};
+
+  /// Slot of `PreviousRaftLoad` - the load of the previous crossing move
+  static constexpr unsigned PreviousRaftLoadSlot{1U};
+
+  /// Count of the variables with fixed slots
+  static constexpr unsigned SlotsCount{2U};
+
+  SymbolsTable() noexcept = default;
+
+  /// Table with the provided names and values
+  SymbolsTable(
+      std::initializer_list<std::pair<std::string, double>> symbols) {
+    for (const auto& [name, value] : symbols)
+      operator[](name) = value;
+  }
+
+  SymbolsTable(const SymbolsTable&) = default;
+  SymbolsTable(SymbolsTable&&) noexcept = default;
+  ~SymbolsTable() noexcept = default;
+
+  SymbolsTable& operator=(const SymbolsTable&) = default;
+  SymbolsTable& operator=(SymbolsTable&&) noexcept = default;
+
+  /// @return the fixed slot of the variable `name` or nothing if it has none
+  [[nodiscard]] static std::optional<unsigned> slotOf(
+      std::string_view name) noexcept {
+    if (name == "CrossingIndex")
+      return CrossingIndexSlot;
+    if (name == "PreviousRaftLoad")
+      return PreviousRaftLoadSlot;
+    return {};
+  }
+
+  /**
+  @return the name of the variable from `slot`
+  @throw out_of_range for an invalid slot
+  */
+  [[nodiscard]] static std::string nameOf(unsigned slot) {
+    switch (slot) {
+      case CrossingIndexSlot:
+        return "CrossingIndex";
+      case PreviousRaftLoadSlot:
+        return "PreviousRaftLoad";
+      default:
+        throw std::out_of_range{HERE.function_name() + " - Invalid slot: "s +
+                                std::to_string(slot)};
+    }
+  }
+
+  /// @return true if there's no symbol in the table
+  [[nodiscard]] bool empty() const noexcept {
+    for (const bool isSet : defined)
+      if (isSet)
+        return false;
+    return others.empty();
+  }
+
+  /// @return true if the variable from `slot` has a value
+  [[nodiscard]] bool contains(unsigned slot) const noexcept {
+    return slot < SlotsCount && defined[slot];
+  }
+
+  /// @return true if the variable `name` has a value
+  [[nodiscard]] bool contains(const std::string& name) const {
+    if (const std::optional<unsigned> slot{slotOf(name)})
+      return contains(*slot);
+    return others.contains(name);
+  }
+
+  /**
+  @return the value of the variable from `slot`
+  @throw out_of_range when the variable has no value
+  */
+  [[nodiscard]] double at(unsigned slot) const {
+    if (!contains(slot))
+      throw std::out_of_range{HERE.function_name() + " - Unknown symbol `"s +
+                              nameOf(slot) + "`!"s};
+    return values[slot];
+  }
+
+  /**
+  @return the value of the variable `name`
+  @throw out_of_range when the variable has no value
+  */
+  [[nodiscard]] double at(const std::string& name) const {
+    if (const std::optional<unsigned> slot{slotOf(name)})
+      return at(*slot);
+
+    const auto it{others.find(name)};
+    if (it == std::cend(others))
+      throw std::out_of_range{HERE.function_name() + " - Unknown symbol `"s +
+                              name + "`!"s};
+    return it->second;
+  }
+
+  /**
+  @return the value of the variable from `slot`, which gets 0 if missing
+  @throw out_of_range for an invalid slot
+  */
+  double& operator[](unsigned slot) {
+    if (!defined.at(slot)) {
+      defined[slot] = true;
+      values[slot] = 0.;
+    }
+    return values[slot];
+  }
+
+  /// @return the value of the variable `name`, which gets 0 if missing
+  double& operator[](const std::string& name) {
+    if (const std::optional<unsigned> slot{slotOf(name)})
+      return operator[](*slot);
+    return others[name];
+  }
+
+  /// Removes the variable from `slot`. @return the count of removed symbols
+  size_t erase(unsigned slot) noexcept {
+    if (!contains(slot))
+      return 0ULL;
+    defined[slot] = false;
+    return 1ULL;
+  }
+
+  /// Removes the variable `name`. @return the count of removed symbols
+  size_t erase(const std::string& name) {
+    if (const std::optional<unsigned> slot{slotOf(name)})
+      return erase(*slot);
+    return others.erase(name);
+  }
+
+  PROTECTED :
+
+      /// The values of the variables with fixed slots, indexed by their slots
+      std::array<double, SlotsCount>
+          values{};
+
+  /// Which slots have values
+  std::array<bool, SlotsCount> defined{};
+
+  /// The variables without fixed slots
+  std::map<std::string, double> others;
+};
 
 /**
 When setting the initial state of a scenario,
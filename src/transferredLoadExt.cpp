@@ -13,6 +13,7 @@
 #include "precompiled.h"
 // This keeps precompiled.h first; Otherwise header sorting might move it
 
+#include "configConstraint.h"
 #include "mathRelated.h"
 #include "transferredLoadExt.h"
 #include "util.h"
@@ -20,7 +21,9 @@
 #include <cassert>
 #include <cmath>
 #include <iostream>
+#include <memory>
 #include <numeric>
+#include <optional>
 #include <sstream>
 
 #include <gsl/pointers>
@@ -51,17 +54,17 @@ void TotalLoadExt::_addMovePostProcessing(SymbolsTable& SymTb) const noexcept {
   // The initial fake move moves no entities, so the load is 0,
   // thus no need to update the Symbols Table
   if (load > Eps)
-    SymTb["PreviousRaftLoad"] = load;
+    SymTb[SymbolsTable::PreviousRaftLoadSlot] = load;
 }
 
 void TotalLoadExt::_removeMovePostProcessing(
     SymbolsTable& SymTb) const noexcept {
   if (load > Eps)
-    SymTb["PreviousRaftLoad"] = load;
+    SymTb[SymbolsTable::PreviousRaftLoadSlot] = load;
   else
     // The initial fake move moves no entities, so the load is 0,
     // thus `PreviousRaftLoad` must be removed from the Symbols Table
-    SymTb.erase("PreviousRaftLoad");
+    SymTb.erase(SymbolsTable::PreviousRaftLoadSlot);
 }
 
 unique_ptr<IMovingEntitiesExt> TotalLoadExt::_clone(
@@ -195,11 +198,10 @@ boost::logic::tribool InitiallyNoPrevRaftLoadExcHandler::assess(
   if (!dependsOnPreviousRaftLoad)
     return boost::logic::indeterminate;
 
-  const auto stEnd = cend(st), itCrossingIndex = st.find("CrossingIndex");
   const bool isInitialState{
-      !st.contains("PreviousRaftLoad")            // missing PreviousRaftLoad
-      && (itCrossingIndex != stEnd)               // existing CrossingIndex
-      && (itCrossingIndex->second <= 1. + Eps)};  // CrossingIndex <= 1
+      !st.contains(SymbolsTable::PreviousRaftLoadSlot)  // no PreviousRaftLoad
+      && st.contains(SymbolsTable::CrossingIndexSlot)   // has CrossingIndex
+      && (st.at(SymbolsTable::CrossingIndexSlot) <= 1. + Eps)};  // <= 1
   if (isInitialState)
     return true;
 
@@ -213,7 +215,9 @@ bool AllowedLoadsValidator::doValidate(const ent::MovingEntities& ents,
           ents.getExtension())};
 
   const double entsWeight{totalLoadExt->totalLoad()};
-  const bool valid{_allowedLoads->contains(entsWeight, st)};
+  const bool valid{allowedLoadsProgram
+                       ? (allowedLoadsProgram->run(st, entsWeight) != 0.)
+                       : _allowedLoads->contains(entsWeight, st)};
 #ifndef NDEBUG
   if (!valid)
     cout << "Invalid load [" << entsWeight << " outside " << *_allowedLoads
@@ -229,7 +233,17 @@ AllowedLoadsValidator::AllowedLoadsValidator(
     const shared_ptr<const IValidatorExceptionHandler>& ownValidatorExcHandler_
     /* = {}*/) noexcept
     : AbsContextValidator{nextValidator_, ownValidatorExcHandler_},
-      _allowedLoads{allowedLoads} {}
+      _allowedLoads{allowedLoads} {
+  // The program is just a faster alternative to _allowedLoads->contains,
+  // so failing to build it (out of memory) leaves the validator working
+  try {
+    if (optional<ExprProgram> program{
+            ExprProgram::compileContains(*_allowedLoads)})
+      allowedLoadsProgram = make_shared<const ExprProgram>(std::move(*program));
+  } catch (...) {
+    allowedLoadsProgram.reset();
+  }
+}
 
 }  // namespace cond
 
@@ -313,17 +327,14 @@ PrevLoadStateExt::PrevLoadStateExt(const SymbolsTable& symbols,
                                    /*= DefStateExt::SHARED_INST()*/)
     : AbsStateExt{info_, nextExt_} {
   // PreviousRaftLoad should miss from Symbols Table when CrossingIndex <= 1
-  const auto stEnd = cend(symbols);
-  const auto itCrossingIndex = symbols.find("CrossingIndex"),
-             itPreviousRaftLoad = symbols.find("PreviousRaftLoad");
-  if (itCrossingIndex == stEnd)
+  if (!symbols.contains(SymbolsTable::CrossingIndexSlot))
     throw logic_error{HERE.function_name() +
                       " - needs to get `symbols` table containing an entry for "
                       "CrossingIndex!"s};
 
-  crossingIndex = gsl::narrow_cast<unsigned>(
-      floor(.5 + itCrossingIndex->second));  // rounded value
-  if (itPreviousRaftLoad == stEnd) {
+  crossingIndex = gsl::narrow_cast<unsigned>(floor(
+      .5 + symbols.at(SymbolsTable::CrossingIndexSlot)));  // rounded value
+  if (!symbols.contains(SymbolsTable::PreviousRaftLoadSlot)) {
     if (crossingIndex >= 2U)
       throw logic_error{HERE.function_name() +
                         " - needs to get `symbols` table containing an entry "
@@ -333,7 +344,7 @@ PrevLoadStateExt::PrevLoadStateExt(const SymbolsTable& symbols,
     previousRaftLoad = numeric_limits<double>::quiet_NaN();
 
   } else
-    previousRaftLoad = itPreviousRaftLoad->second;
+    previousRaftLoad = symbols.at(SymbolsTable::PreviousRaftLoadSlot);
 }
 
 double PrevLoadStateExt::prevRaftLoad() const noexcept {
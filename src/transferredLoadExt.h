@@ -223,6 +223,9 @@ class AllowedLoadsValidator : public AbsContextValidator {
 
   /// The allowed loads
   gsl::not_null<std::shared_ptr<const IValues<double>>> _allowedLoads;
+
+  /// The compiled membership test for _allowedLoads or NULL if not compilable
+  std::shared_ptr<const ExprProgram> allowedLoadsProgram;
 };
 
 }  // namespace cond
@@ -755,6 +755,98 @@ BOOST_AUTO_TEST_CASE(notPredicate_usecases) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(exprProgram_usecases) {
+  using namespace std;
+  using namespace rc;
+  using namespace rc::cond;
+
+  bool b{};
+  const string var1{"a"}, var2{"b"};
+  const shared_ptr<const NumericExpr> c1{make_shared<const NumericConst>(1.)},
+      c2{make_shared<const NumericConst>(2.)},
+      c5{make_shared<const NumericConst>(5.)},
+      v1{make_shared<const NumericVariable>(var1)},
+      v2{make_shared<const NumericVariable>(var2)};
+
+  // The well-known symbols have fixed slots
+  BOOST_CHECK(SymbolsTable::slotOf("CrossingIndex") ==
+              SymbolsTable::CrossingIndexSlot);
+  BOOST_CHECK(SymbolsTable::slotOf("PreviousRaftLoad") ==
+              SymbolsTable::PreviousRaftLoadSlot);
+  BOOST_CHECK(SymbolsTable::nameOf(SymbolsTable::CrossingIndexSlot) ==
+              "CrossingIndex");
+  BOOST_CHECK(!SymbolsTable::slotOf(var1));
+  {
+    // Other symbols belong only to the table which received them
+    SymbolsTable st{{var1, 3.}, {"CrossingIndex", 2.}};
+    BOOST_CHECK(st.contains(var1) && !st.contains(var2));
+    BOOST_CHECK(st.at(var1) == 3.);
+    BOOST_CHECK(st.at(SymbolsTable::CrossingIndexSlot) == 2.);
+    BOOST_CHECK(!SymbolsTable{}.contains(var1));
+
+    // Failed lookups don't add the symbol
+    BOOST_CHECK_THROW(ignore = st.at(var2), out_of_range);
+    BOOST_CHECK(!st.contains(var2));
+    st.erase(var1);
+    st.erase(SymbolsTable::CrossingIndexSlot);
+    BOOST_CHECK(st.empty());
+  }
+
+  // mod(add(a, 1), b) in {2, 5 .. add(b, 5)}
+  const shared_ptr<const Addition> sumPtr{make_shared<const Addition>(v1, c1)};
+  const shared_ptr<const Modulus> modPtr{
+      make_shared<const Modulus>(sumPtr, v2)};
+  ValueSet* const pVs{new ValueSet};
+  pVs->add(ValueOrRange{c2}).add({c5, make_shared<const Addition>(v2, c5)});
+  const shared_ptr<const IValues<double> > vs{shared_ptr<const ValueSet>(pVs)};
+  const shared_ptr<const BelongToCondition<double> > belongsPtr{
+      make_shared<const BelongToCondition<double> >(modPtr, vs)};
+  const Addition& sum{*sumPtr};
+  const Modulus& mod{*modPtr};
+  const BelongToCondition<double>& belongs{*belongsPtr};
+  const Not notBelongs{belongsPtr};
+
+  const optional<ExprProgram> sumProg{ExprProgram::compile(sum)},
+      modProg{ExprProgram::compile(mod)},
+      belongsProg{ExprProgram::compile(belongs)},
+      notBelongsProg{ExprProgram::compile(notBelongs)},
+      containsProg{ExprProgram::compileContains(*vs)};
+  BOOST_REQUIRE(sumProg && modProg && belongsProg && notBelongsProg &&
+                containsProg);
+
+  // The programs match the evaluation of the expression trees
+  for (double a{}; a < 20.; ++a) {
+    for (double bVal : {3., 7., 11.}) {
+      BOOST_TEST_CONTEXT("for a = " << a << " and b = " << bVal) {
+        const SymbolsTable st{{var1, a}, {var2, bVal}};
+        BOOST_CHECK(sumProg->run(st) == sum.eval(st));
+        BOOST_CHECK(modProg->run(st) == mod.eval(st));
+        BOOST_CHECK((belongsProg->run(st) != 0.) == belongs.eval(st));
+        BOOST_CHECK((notBelongsProg->run(st) != 0.) == notBelongs.eval(st));
+        BOOST_CHECK((containsProg->run(st, a) != 0.) == vs->contains(a, st));
+      }
+    }
+  }
+
+  // The programs report the same errors as the expression trees
+  BOOST_CHECK_THROW(ignore = sumProg->run(SymbolsTable{}), out_of_range);
+  BOOST_CHECK_THROW(ignore = modProg->run(SymbolsTable{{var1, 1.}, {var2, 0.}}),
+                    overflow_error);
+  BOOST_CHECK_THROW(
+      ignore = modProg->run(SymbolsTable{{var1, 1.5}, {var2, 3.}}),
+      logic_error);
+  BOOST_CHECK_THROW(
+      ignore = containsProg->run(SymbolsTable{{var2, NAN}}, 1.),
+      logic_error);
+
+  // Constant expressions compile as well
+  const optional<ExprProgram> constProg{
+      ExprProgram::compile(BoolConst{true})};
+  BOOST_CHECK(b = (bool)constProg);
+  if (b)
+    BOOST_CHECK(constProg->run(SymbolsTable{}) != 0.);
+}
+
 BOOST_AUTO_TEST_CASE(typesConstraint_usecases) {
   using namespace std;
   using namespace rc::cond;
@@ -917,6 +1009,67 @@ BOOST_AUTO_TEST_CASE(typesConstraint_usecases) {
   BOOST_CHECK_NO_THROW(BOOST_CHECK(!tc.matches(be)));     // unwanted type 't3'
 }
 
+BOOST_AUTO_TEST_CASE(typesConstraintMaskProgram_usecases) {
+  using namespace std;
+  using namespace rc::cond;
+  using namespace rc::ent;
+
+  auto pAe{make_unique<AllEntities>()};
+  AllEntities& ae{*pAe};
+  shared_ptr<const AllEntities> spAe{pAe.release()};
+  try {  // Available: 2 x t0 + 2 x t1 + 2 x t2 + t3 + t4 + t5
+    ae += make_shared<const Entity>(0U, "e0", "t0", false, "true");
+    ae += make_shared<const Entity>(1U, "e1", "t0", false, "false");
+    ae += make_shared<const Entity>(2U, "e2", "t1", false, "true");
+    ae += make_shared<const Entity>(3U, "e3", "t1", false, "false");
+    ae += make_shared<const Entity>(4U, "e4", "t2", false, "true");
+    ae += make_shared<const Entity>(5U, "e5", "t2", false, "false");
+    ae += make_shared<const Entity>(6U, "e6", "t3", false, "true");
+    ae += make_shared<const Entity>(7U, "e7", "t4", false, "true");
+    ae += make_shared<const Entity>(8U, "e8", "t5", false, "true");
+  } catch (...) {
+    BOOST_REQUIRE(false);  // Unexpected exception
+  }
+
+  // The types are interned in the order of their appearance
+  BOOST_REQUIRE(ae.typesCount() == 6ULL);
+  BOOST_CHECK(ae.typeIndex("t0") == 0U);
+  BOOST_CHECK(ae.typeIndex("t5") == 5U);
+  BOOST_CHECK(ae.typesMasks()[1ULL] == 0b1100ULL);
+
+  TypesConstraint tc1, tc2, tc3;
+  tc1.addTypeRange("t0", 1U, 2U).addTypeRange("t1", 0U, 2U).addTypeRange(
+      "t5", 1U);  // 't0'{1,2} 't1'{,2} 't5'{1,}
+  tc2.addTypeRange("t2", 2U, 2U)
+      .addTypeRange("t3", 0U, 1U)
+      .addTypeRange("t4", 0U, 0U);  // 't2'{2} 't3'{,1} 't4'{0}
+  tc3.addTypeRange("t1", 1U);       // 't1'{1,}
+
+  // The matches of the compiled constraints agree with the uncompiled ones
+  for (const TypesConstraint* pTc : {&tc1, &tc2, &tc3}) {
+    const TypesConstraint uncompiled{*pTc};
+    BOOST_REQUIRE(!uncompiled.maskProgram);
+
+    BOOST_REQUIRE_NO_THROW(pTc->validate(ae));
+    BOOST_REQUIRE(pTc->maskProgram);
+
+    const IdsMask fullMask{ae.fullMask()};
+    for (IdsMask mask{}; mask <= fullMask; ++mask) {
+      const BankEntities be{spAe, mask};
+      BOOST_TEST_CONTEXT("for constraint: `" << *pTc << "` and bank: `" << be
+                                             << '`') {
+        BOOST_CHECK(pTc->matches(be) == uncompiled.matches(be));
+      }
+    }
+  }
+
+  // Changing a constraint drops its compiled form until a new validation
+  tc3.addTypeRange("t0", 0U, 1U);
+  BOOST_CHECK(!tc3.maskProgram);
+  BOOST_REQUIRE_NO_THROW(tc3.validate(ae));
+  BOOST_CHECK(tc3.maskProgram);
+}
+
 BOOST_AUTO_TEST_CASE(idsConstraint_usecases) {
   using namespace std;
   using namespace rc::cond;
@@ -1112,6 +1265,85 @@ BOOST_AUTO_TEST_CASE(idsConstraint_usecases) {
   BOOST_CHECK_THROW(ic.validate(ae), logic_error);
 }
 
+BOOST_AUTO_TEST_CASE(idsConstraintMaskProgram_usecases) {
+  using namespace std;
+  using namespace rc::cond;
+  using namespace rc::ent;
+
+  auto pAe{make_unique<AllEntities>()};
+  AllEntities& ae{*pAe};
+  shared_ptr<const AllEntities> spAe{pAe.release()};
+  try {  // Available: 2 x t0 + 2 x t1 + 2 x t2 + t3 + t4 + t5
+    ae += make_shared<const Entity>(0U, "e0", "t0", false, "true");
+    ae += make_shared<const Entity>(1U, "e1", "t0", false, "false");
+    ae += make_shared<const Entity>(2U, "e2", "t1", false, "true");
+    ae += make_shared<const Entity>(3U, "e3", "t1", false, "false");
+    ae += make_shared<const Entity>(4U, "e4", "t2", false, "true");
+    ae += make_shared<const Entity>(5U, "e5", "t2", false, "false");
+    ae += make_shared<const Entity>(6U, "e6", "t3", false, "true");
+    ae += make_shared<const Entity>(7U, "e7", "t4", false, "true");
+    ae += make_shared<const Entity>(8U, "e8", "t5", false, "true");
+  } catch (...) {
+    BOOST_REQUIRE(false);  // Unexpected exception
+  }
+
+  IdsConstraint ic1, ic2, ic3;
+  // not(1) (2|3)? (6|7|8) .{1}
+  ic1.addAvoidedId(1U)
+      .addOptionalGroup(vector{2U, 3U})
+      .addMandatoryGroup(vector{6U, 7U, 8U})
+      .addUnspecifiedMandatory();
+  // 0 4? * ...
+  ic2.addMandatoryId(0U)
+      .addOptionalId(4U)
+      .addUnspecifiedMandatory()
+      .setUnbounded();
+  // (0|1) (2|3) (4|5)? not(8)
+  ic3.addMandatoryGroup(vector{0U, 1U})
+      .addMandatoryGroup(vector{2U, 3U})
+      .addOptionalGroup(vector{4U, 5U})
+      .addAvoidedId(8U);
+
+  // The matches of the compiled constraints agree with the uncompiled ones
+  for (const IdsConstraint* pIc : {&ic1, &ic2, &ic3}) {
+    const IdsConstraint uncompiled{*pIc};
+    BOOST_REQUIRE(!uncompiled.maskProgram);
+
+    BOOST_REQUIRE_NO_THROW(pIc->validate(ae));
+    BOOST_REQUIRE(pIc->maskProgram);
+
+    const IdsMask fullMask{ae.fullMask()};
+    for (IdsMask mask{}; mask <= fullMask; ++mask) {
+      const BankEntities be{spAe, mask};
+      BOOST_TEST_CONTEXT("for constraint: `" << *pIc << "` and bank: `" << be
+                                             << '`') {
+        BOOST_CHECK(pIc->matches(be) == uncompiled.matches(be));
+      }
+    }
+  }
+
+  // Changing a constraint drops its compiled form until a new validation
+  ic1.addOptionalId(5U);
+  BOOST_CHECK(!ic1.maskProgram);
+  BOOST_REQUIRE_NO_THROW(ic1.validate(ae));
+  BOOST_CHECK(ic1.maskProgram);
+
+  // Matching entities from another pool ignores the compiled form
+  auto pOtherAe{make_unique<AllEntities>()};
+  AllEntities& otherAe{*pOtherAe};
+  shared_ptr<const AllEntities> spOtherAe{pOtherAe.release()};
+  try {  // 0 and 6 swap their bits compared to ae
+    for (const unsigned id : {6U, 1U, 2U, 3U, 4U, 5U, 0U})
+      otherAe += make_shared<const Entity>(id, "e" + to_string(id), "t0",
+                                           false, "true");
+  } catch (...) {
+    BOOST_REQUIRE(false);  // Unexpected exception
+  }
+  BankEntities otherBe{spOtherAe};
+  BOOST_CHECK(ic1.matches(otherBe = {0U, 6U}));   // 0 is an extra id
+  BOOST_CHECK(!ic1.matches(otherBe = {0U, 2U}));  // misses (6|7|8)
+}
+
 BOOST_AUTO_TEST_CASE(configConstraints_usecases) {
   using namespace std;
   using namespace rc;
@@ -1273,6 +1505,107 @@ BOOST_AUTO_TEST_CASE(configConstraints_usecases) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(banksConstraints_usecases) {
+  using namespace std;
+  using namespace rc;
+  using namespace rc::cond;
+  using namespace rc::ent;
+
+  auto pAe{make_unique<AllEntities>()};
+  AllEntities& ae{*pAe};
+  shared_ptr<const AllEntities> spAe{pAe.release()};
+  try {  // Available: 2 x t0 + 2 x t1 + 2 x t2 + t3 + t4 + t5
+    ae += make_shared<const Entity>(0U, "e0", "t0", false, "true");
+    ae += make_shared<const Entity>(1U, "e1", "t0", false, "false");
+    ae += make_shared<const Entity>(2U, "e2", "t1", false, "true");
+    ae += make_shared<const Entity>(3U, "e3", "t1", false, "false");
+    ae += make_shared<const Entity>(4U, "e4", "t2", false, "true");
+    ae += make_shared<const Entity>(5U, "e5", "t2", false, "false");
+    ae += make_shared<const Entity>(6U, "e6", "t3", false, "true");
+    ae += make_shared<const Entity>(7U, "e7", "t4", false, "true");
+    ae += make_shared<const Entity>(8U, "e8", "t5", false, "true");
+  } catch (...) {
+    BOOST_REQUIRE(false);  // Unexpected exception
+  }
+
+  try {  // the tabulated verdicts match the ones of ConfigConstraints
+    shared_ptr<const IdsConstraint> ic{make_shared<const IdsConstraint>()};
+    IdsConstraint* pIc{const_cast<IdsConstraint*>(ic.get())};
+    // not(1) (2|3)? (6|7|8) .{1}
+    pIc->addAvoidedId(1U)
+        .addOptionalGroup(vector{2U, 3U})
+        .addMandatoryGroup(vector{6U, 7U, 8U})
+        .addUnspecifiedMandatory();
+
+    shared_ptr<const TypesConstraint> tc{make_shared<const TypesConstraint>()};
+    TypesConstraint* pTc{const_cast<TypesConstraint*>(tc.get())};
+    // 't0'{1,2} 't1'{,2} 't5'{1,}
+    pTc->addTypeRange("t0", 1U, 2U).addTypeRange("t1", 0U, 2U).addTypeRange(
+        "t5", 1U);
+
+    for (const bool allowed : {true, false}) {
+      const ConfigConstraints cc{{ic, tc}, ae, allowed};
+      const BanksConstraints bc{{ic, tc}, spAe, allowed};
+      BOOST_CHECK(bc.allowed() == allowed);
+      BOOST_REQUIRE(size(bc.validBanks) == 8ULL);  // 2^9 bits
+      BOOST_CHECK(bc.cachedVerdicts.empty());
+      BOOST_CHECK(ranges::none_of(bc.checkedBanks, [](const auto& word) {
+        return word.load() != 0ULL;
+      }));  // nothing computed before the first check
+
+      const IdsMask fullMask{ae.fullMask()};
+      for (IdsMask mask{}; mask <= fullMask; ++mask) {
+        const BankEntities be{spAe, mask};
+        BOOST_TEST_CONTEXT("for bank: `" << be << "` and allowed: "
+                                          << allowed) {
+          BOOST_CHECK(bc.check(be) == cc.check(be));
+        }
+      }
+      BOOST_CHECK(bc.cachedVerdicts.empty());
+      BOOST_CHECK(ranges::all_of(bc.checkedBanks, [](const auto& word) {
+        return word.load() == ~0ULL;
+      }));  // all 2^9 banks were checked
+    }
+  } catch (...) {
+    BOOST_CHECK(false);  // Unexpected exception
+  }
+
+  auto pManyAe{make_unique<AllEntities>()};
+  AllEntities& manyAe{*pManyAe};
+  shared_ptr<const AllEntities> spManyAe{pManyAe.release()};
+  try {  // more entities than BanksConstraints::MaxTabulatedEntities
+    for (unsigned id{}; id <= (unsigned)BanksConstraints::MaxTabulatedEntities;
+         ++id)
+      manyAe += make_shared<const Entity>(id, "e" + to_string(id), "t0", false,
+                                          "true");
+  } catch (...) {
+    BOOST_REQUIRE(false);  // Unexpected exception
+  }
+
+  try {  // the verdicts are cached on demand
+    shared_ptr<const IdsConstraint> ic{make_shared<const IdsConstraint>()};
+    IdsConstraint* pIc{const_cast<IdsConstraint*>(ic.get())};
+    pIc->addAvoidedId(1U).addMandatoryId(2U);  // not(1) 2
+
+    const ConfigConstraints cc{{ic}, manyAe};
+    const BanksConstraints bc{{ic}, spManyAe};
+    BOOST_CHECK(bc.validBanks.empty());
+
+    BankEntities be{spManyAe};
+    BOOST_CHECK(bc.check(be = {2U}));
+    BOOST_CHECK(!bc.check(be = {1U, 2U}));
+    BOOST_CHECK(!bc.check(be = {3U}));
+    BOOST_CHECK(size(bc.cachedVerdicts) == 3ULL);
+
+    // repeated checks reuse the cached verdicts
+    BOOST_CHECK(bc.check(be = {2U}) == cc.check(be));
+    BOOST_CHECK(bc.check(be = {1U, 2U}) == cc.check(be));
+    BOOST_CHECK(size(bc.cachedVerdicts) == 3ULL);
+  } catch (...) {
+    BOOST_CHECK(false);  // Unexpected exception
+  }
+}
+
 BOOST_AUTO_TEST_CASE(transferConstraints_usecases) {
   using namespace std;
   using namespace rc;
@@ -646,6 +646,88 @@ BOOST_AUTO_TEST_CASE(bankEntities_usecases) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(bankEntitiesMasks_usecases) {
+  using namespace std;
+  using namespace rc;
+  using namespace rc::ent;
+
+  // Pools with AllEntities::MaxMaskedEntities entities use masks,
+  // while larger pools keep the ids only in sets
+  for (const size_t entsCount : {AllEntities::MaxMaskedEntities,
+                                 AllEntities::MaxMaskedEntities + 1U}) {
+    BOOST_TEST_CONTEXT("for a pool of " << entsCount << " entities") {
+      auto pAe{make_unique<AllEntities>()};
+      AllEntities& ae{*pAe};
+      auto spAe{shared_ptr<const AllEntities>(pAe.release())};
+
+      try {
+        // ids in decreasing order, to differ from the bit positions
+        for (size_t i{}; i < entsCount; ++i) {
+          const unsigned id{unsigned(2ULL * (entsCount - i))};
+          ae += make_shared<const Entity>(id, "e"s + to_string(id), "t"s,
+                                          false, "true");
+        }
+      } catch (...) {
+        BOOST_REQUIRE(false);  // Unexpected exception
+      }
+
+      const bool masked{entsCount <= AllEntities::MaxMaskedEntities};
+      BOOST_CHECK(ae.masksAllowed() == masked);
+
+      try {
+        BankEntities be{spAe, vector{2U, 4U, 6U}}, be1{spAe};
+        MovingEntities me{spAe, vector{4U, 8U}};
+
+        BOOST_CHECK(be.idsMask().has_value() == masked);
+        if (masked) {
+          BOOST_CHECK(ae.fullMask() == ~IdsMask{});
+          BOOST_CHECK(*be.idsMask() == ((IdsMask{7ULL} << (entsCount - 3ULL))));
+          BOOST_CHECK(ae.idOfBit(0U) == unsigned(2ULL * entsCount));
+        } else {
+          BOOST_CHECK_THROW(ignore = ae.maskOf(2U), logic_error);
+        }
+
+        BOOST_CHECK(be.count() == 3ULL);
+        BOOST_CHECK(be == set({2U, 4U, 6U}));
+        BOOST_CHECK((~be).count() == entsCount - 3ULL);
+        BOOST_CHECK(~~be == be);
+        BOOST_CHECK(be.differencesCount(be1) == 3ULL);
+        BOOST_CHECK(be.idsByTypes().at("t") == set({2U, 4U, 6U}));
+
+        // the only type is interned as 0
+        BOOST_CHECK(ae.typesCount() == 1ULL);
+        BOOST_CHECK(ae.typeIndex("t") == 0U);
+        BOOST_CHECK(!ae.typeIndex("u"));
+        BOOST_CHECK(be.countOfType(0U) == 3U);
+        if (masked)
+          BOOST_CHECK(ae.typesMasks() == vector{~IdsMask{}});
+        else
+          BOOST_CHECK_THROW(ignore = ae.typesMasks(), logic_error);
+
+        // checked on copies, since the sets of ids might get altered partially
+        BOOST_CHECK_THROW(BankEntities{be} += me, domain_error);  // dupl. id 4
+        BOOST_CHECK_THROW(BankEntities{be} -= me, domain_error);  // missing 8
+
+        be1 += me;
+        BOOST_CHECK(be1 == set({4U, 8U}));
+        BOOST_CHECK(be.differencesCount(be1) == 3ULL);  // 2,6,8
+        be1 -= me;
+        BOOST_CHECK(be1.empty());
+
+        BankEntities be2{be};
+        be2 -= me = {2U};
+        BOOST_CHECK(be2 == set({4U, 6U}));
+        BOOST_CHECK(be2 != be);
+        be2 = be;
+        BOOST_CHECK(be2 == be);
+        BOOST_CHECK(be2 == set({2U, 4U, 6U}));
+      } catch (...) {
+        BOOST_CHECK(false);  // Unexpected exception
+      }
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 #endif  // for CPP_ENTITIES_MANAGER and UNIT_TESTING
@@ -19,6 +19,7 @@ and the define by `#ifdef UNIT_TESTING`!"
 
 #else  // for CPP_SCENARIO and UNIT_TESTING
 
+#include "durationExt.h"
 #include "mathRelated.h"
 #include "scenario.h"
 
@@ -50,6 +51,18 @@ void tackleScenario(const fs::path& file,
   if (dfsSolLen > 0ULL)
     ++solved;
 
+  // A* finds solutions as short as BFS
+  BOOST_CHECK(scenario.solution(rc::Scenario::Algorithm::AStar)
+                  .attempt->length() == bfsSolLen);
+
+  // The bidirectional BFS finds solutions as short as BFS
+  BOOST_CHECK(scenario.solution(rc::Scenario::Algorithm::BidirectionalBFS)
+                  .attempt->length() == bfsSolLen);
+
+  // The fastest solution exists whenever there is a solution
+  BOOST_CHECK((scenario.solution(rc::Scenario::Algorithm::UniformCost)
+                   .attempt->length() > 0ULL) == (bfsSolLen > 0ULL));
+
   if (bfsSolLen != dfsSolLen) {
     ++BFS_DFS_notableDiffs;
     if (bfsSolLen > 0ULL && dfsSolLen > 0ULL)
@@ -1574,6 +1587,518 @@ BOOST_AUTO_TEST_CASE(timeLimitValidation) {
     )"}});
 }
 
+BOOST_AUTO_TEST_CASE(uniformCostSearch) {
+  using namespace std;
+  using rc::Scenario;
+
+  // Crossing the bridge 3 at a time is slow, while the solutions with the
+  // fewest crossings need such a crossing
+  Scenario s{istringstream{R"(
+      {"ScenarioDescription": ["People crossing a bridge with a torch"],
+
+      "Entities" : [
+        {"Id": 0,
+        "CanTackleBridgeCrossing": "true",
+        "Name": "Person1"},
+        {"Id": 1,
+        "CanTackleBridgeCrossing": "true",
+        "Name": "Person2"},
+        {"Id": 2,
+        "CanTackleBridgeCrossing": "true",
+        "Name": "Person3"},
+        {"Id": 3,
+        "CanTackleBridgeCrossing": "true",
+        "Name": "Person4"}
+        ],
+
+      "CrossingConstraints" : {
+        "BridgeCapacity": 3,
+        "CrossingDurationsOfConfigurations": [
+            "100 : 0 1 (2 | 3) ; 0 2 3 ; 1 2 3",
+            "1 : 0 (1 | 2 | 3)? ; 1 (2 | 3)? ; 2 3? ; 3"
+          ]
+        },
+
+      "OtherConstraints" : {
+        "TimeLimit": 300
+        }
+      }
+    )"}};
+
+  const auto timeOfSolution = [](const Scenario::Results& res) {
+    BOOST_REQUIRE(res.attempt && res.attempt->isSolution());
+    return rc::sol::AbsStateExt::selectExt<rc::sol::TimeStateExt>(
+               res.attempt->lastMove().resultedState()->getExtension().get())
+        ->time();
+  };
+
+  const Scenario::Results& bfsRes{s.solution(true)};
+  BOOST_CHECK(bfsRes.attempt && bfsRes.attempt->length() == 3ULL);
+  const unsigned bfsTime{timeOfSolution(bfsRes)},
+      ucsTime{timeOfSolution(s.solution(Scenario::Algorithm::UniformCost))};
+  BOOST_CHECK(bfsTime > 100U);
+  BOOST_CHECK(ucsTime == 5U);  // 2 people cross at a time, 1 returns
+  BOOST_CHECK(ucsTime < bfsTime);
+}
+
+BOOST_AUTO_TEST_CASE(interruptedDfsResumed) {
+  using namespace std;
+  using rc::Scenario;
+
+  const fs::path dir{rc::projectFolder()};
+  BOOST_REQUIRE(!dir.empty());
+  const fs::path file{dir / "Scenarios" / "wolfGoatCabbage.json"};
+  Scenario unlimited{ifstream{file}}, s{ifstream{file}};
+  const Scenario::Results& whole{unlimited.solution(Scenario::Algorithm::DFS)};
+  BOOST_REQUIRE(whole.attempt->isSolution());
+
+  const Scenario::Results& limited{s.explore(Scenario::Algorithm::DFS, 1U, 1U)};
+  BOOST_CHECK(limited.interrupted);
+  BOOST_CHECK(!limited.attempt->isSolution());
+
+  // The saved DFS is a valid form even within another Scenario
+  ostringstream saved;
+  BOOST_CHECK(!unlimited.saveInterruptedDfs(saved));
+  BOOST_REQUIRE(s.saveInterruptedDfs(saved));
+
+  // Each call continues the same DFS with a new budget
+  size_t resumptions{};
+  while (s.explore(Scenario::Algorithm::DFS, 1U, 2U).interrupted)
+    ++resumptions;
+  BOOST_CHECK(resumptions > 0ULL);
+  const Scenario::Results& res{s.solution(Scenario::Algorithm::DFS)};
+  BOOST_CHECK(&res == &limited);
+  BOOST_CHECK(!res.interrupted);
+  BOOST_CHECK(res.attempt->toString() == whole.attempt->toString());
+  BOOST_CHECK(res.investigatedStates == whole.investigatedStates);
+
+  // Complete results are reused
+  BOOST_CHECK(&s.explore(Scenario::Algorithm::DFS, 1U, 1U) == &res);
+  BOOST_CHECK(!s.saveInterruptedDfs(saved));
+
+  // Loading the saved DFS within another Scenario
+  Scenario loaded{ifstream{file}};
+  istringstream savedForm{saved.str()};
+  loaded.loadInterruptedDfs(savedForm);
+  BOOST_CHECK(loaded.explore(Scenario::Algorithm::DFS, 1U, 0U).interrupted);
+  const Scenario::Results& resLoaded{
+      loaded.solution(Scenario::Algorithm::DFS)};
+  BOOST_CHECK(!resLoaded.interrupted);
+  BOOST_CHECK(resLoaded.attempt->isSolution());
+
+  // Invalid forms
+  for (const string& form :
+       {""s, "RiverCrossingDfs 0\n1\n"s, "RiverCrossingDfs 1\n0\n"s,
+        saved.str().substr(0ULL, size(saved.str()) - 3ULL)}) {
+    Scenario invalid{ifstream{file}};
+    istringstream invalidForm{form};
+    BOOST_CHECK_THROW(invalid.loadInterruptedDfs(invalidForm), domain_error);
+    BOOST_CHECK(!invalid.saveInterruptedDfs(saved));
+  }
+
+  // The form of another scenario
+  Scenario other{ifstream{dir / "Scenarios" / "familyAndBag.json"}};
+  savedForm.clear();
+  savedForm.seekg(0);
+  BOOST_CHECK_THROW(other.loadInterruptedDfs(savedForm), domain_error);
+}
+
+BOOST_AUTO_TEST_CASE(interactiveOutput) {
+  using namespace std;
+  using namespace boost::property_tree;
+  using rc::Scenario;
+
+  Scenario s{istringstream{R"(
+      {"ScenarioDescription": ["A \"quoted\" torch", "Tabbed\tline"],
+
+      "Entities" : [
+        {"Id": 0,
+        "CanTackleBridgeCrossing": "true",
+        "Name": "Person1"},
+        {"Id": 1,
+        "CanTackleBridgeCrossing": "true",
+        "Name": "Person2"},
+        {"Id": 2,
+        "CanTackleBridgeCrossing": "true",
+        "Name": "Person5"}
+        ],
+
+      "CrossingConstraints" : {
+        "BridgeCapacity": 2,
+        "CrossingDurationsOfConfigurations": [
+            "5 : 2 (0 | 1)?",
+            "2 : 1 0?",
+            "1 : 0"
+          ]
+        },
+
+      "OtherConstraints" : {
+        "TimeLimit": 8
+        }
+      }
+    )"}};
+
+  const Scenario::Results& res{s.explore(Scenario::Algorithm::BFS)};
+  BOOST_REQUIRE(res.attempt && res.attempt->isSolution());
+
+  ostringstream oss;
+  streambuf* const origBuf{cout.rdbuf(oss.rdbuf())};
+  s.outputResults(res, true);
+  cout.rdbuf(origBuf);
+
+  // The escaped control characters leave the formatting of cout unchanged
+  BOOST_CHECK(cout.fill() == ' ');
+  BOOST_CHECK((cout.flags() & ios::basefield) == ios::dec);
+  BOOST_CHECK(oss.str().find("Tabbed\\u0009line") != string::npos);
+
+  ptree out;
+  istringstream iss{oss.str()};
+  BOOST_REQUIRE_NO_THROW(read_json(iss, out));
+
+  BOOST_CHECK(out.get_child("ScenarioDescription") == s.descrTree);
+  BOOST_CHECK(out.get_child("ScenarioDescription").front().second.data() ==
+              "A \"quoted\" torch");
+  BOOST_CHECK(out.get_child("ScenarioDescription").back().second.data() ==
+              "Tabbed\tline");
+  BOOST_CHECK(out.get("Bridge", ""s) == "true");
+  BOOST_CHECK(out.get_child("Entities") == s.entTree);
+
+  const ptree& moves{out.get_child("Moves")};
+  BOOST_REQUIRE(moves.size() == res.attempt->length() + 1ULL);
+
+  const auto idsOf = [](const ptree& move, const string& propName) {
+    vector<string> ids;
+    for (const auto& idPair : move.get_child(propName))
+      ids.push_back(idPair.second.data());
+    return ids;
+  };
+
+  const ptree& first{moves.front().second};
+  BOOST_CHECK(first.get("Idx", ""s) == "0");
+  BOOST_CHECK(!first.count("Transferred"));
+  BOOST_CHECK(idsOf(first, "LeftBank") == (vector<string>{"0", "1", "2"}));
+  BOOST_CHECK(idsOf(first, "RightBank").empty());
+
+  const ptree& last{moves.back().second};
+  BOOST_CHECK(last.get("Idx", ""s) == to_string(res.attempt->length()));
+  BOOST_CHECK(!idsOf(last, "Transferred").empty());
+  BOOST_CHECK(idsOf(last, "LeftBank").empty());
+  BOOST_CHECK(idsOf(last, "RightBank") == (vector<string>{"0", "1", "2"}));
+  BOOST_CHECK(!last.get("OtherDetails", ""s).empty());  // the elapsed time
+}
+
+BOOST_AUTO_TEST_CASE(solutionsCache) {
+  using namespace std;
+  using rc::Scenario, rc::SolutionsCache;
+
+  const fs::path dir{fs::temp_directory_path() /
+                     "RiverCrossing_solutionsCache_test"};
+  fs::remove_all(dir);
+
+  const auto scenarioText = [](const string& descr, const string& image,
+                               unsigned capacity) {
+    return R"({"ScenarioDescription": [")" + descr + R"("],
+      "Entities" : [
+        {"Id": 0, "Name": "Farmer", "CanRow": "true",
+        "Image": {"Url": ")" +
+           image + R"("}},
+        {"Id": 1, "Name": "Wolf"},
+        {"Id": 2, "Name": "Goat"},
+        {"Id": 3, "Name": "Cabbage"}
+        ],
+      "CrossingConstraints" : {
+        "RaftCapacity": )" +
+           to_string(capacity) + R"(
+        },
+      "BanksConstraints" : {
+        "ConfigurationsValidity" : false,
+        "Configurations": ["Wolf Goat", "Goat Cabbage"]
+        }
+      })";
+  };
+
+  {
+    const SolutionsCache cache{dir};
+
+    Scenario s1{istringstream{scenarioText("Original", "a.png", 2U)}};
+    BOOST_CHECK(s1.cachedSolution(cache, Scenario::Algorithm::BFS));
+    BOOST_CHECK(s1.resultsByAlgorithm.size() == 1ULL);  // explored
+
+    // Same puzzle with another description and image - reused outcome
+    Scenario s2{istringstream{scenarioText("Changed", "b.png", 2U)}};
+    BOOST_CHECK(s2.cachedSolution(cache, Scenario::Algorithm::BFS, true));
+    BOOST_CHECK(s2.resultsByAlgorithm.empty());
+
+    // Same puzzle with another algorithm - explored
+    BOOST_CHECK(s2.cachedSolution(cache, Scenario::Algorithm::AStar));
+    BOOST_CHECK(s2.resultsByAlgorithm.size() == 1ULL);
+
+    // Different puzzle - explored
+    Scenario s3{istringstream{scenarioText("Original", "a.png", 3U)}};
+    BOOST_CHECK(s3.cachedSolution(cache, Scenario::Algorithm::BFS));
+    BOOST_CHECK(s3.resultsByAlgorithm.size() == 1ULL);
+
+    // Puzzles differing only beyond the 6th significant digit of a weight,
+    // of the max load or of an allowed load - each explored.
+    // The goat cannot cross in the unsolvable ones
+    const auto heavyScenarioText = [](const string& farmerWeight,
+                                      const string& loadConstraint) {
+      return R"({"ScenarioDescription": ["Heavy farmer"],
+      "Entities" : [
+        {"Id": 0, "Name": "Farmer", "CanRow": "true", "Weight": )" +
+             farmerWeight + R"(},
+        {"Id": 1, "Name": "Wolf", "Weight": 2},
+        {"Id": 2, "Name": "Goat", "Weight": 2},
+        {"Id": 3, "Name": "Cabbage", "Weight": 1}
+        ],
+      "CrossingConstraints" : {
+        )" + loadConstraint +
+             R"(
+        },
+      "BanksConstraints" : {
+        "ConfigurationsValidity" : false,
+        "Configurations": ["Wolf Goat", "Goat Cabbage"]
+        }
+      })";
+    };
+    const string heavyFarmer{"1000000"}, maxLoad{R"("RaftMaxLoad": 1000002)"};
+    const vector<pair<string, string>> heavyVariants{
+        // the solvable and the unsolvable puzzle
+        {heavyScenarioText(heavyFarmer, maxLoad),
+         heavyScenarioText(heavyFarmer, R"("RaftMaxLoad": 1000001.4)")},
+        {heavyScenarioText(heavyFarmer,
+                           R"("AllowedRaftLoads": "0 .. 1000002")"),
+         heavyScenarioText(heavyFarmer,
+                           R"("AllowedRaftLoads": "0 .. 1000001.4")")},
+        {heavyScenarioText(heavyFarmer, maxLoad),
+         heavyScenarioText("1000000.4", maxLoad)}};
+    for (const auto& [solvableText, unsolvableText] : heavyVariants) {
+      Scenario solvable{istringstream{solvableText}};
+      BOOST_CHECK(solvable.cachedSolution(cache, Scenario::Algorithm::BFS));
+
+      Scenario unsolvable{istringstream{unsolvableText}};
+      BOOST_CHECK(unsolvable.cacheKey(Scenario::Algorithm::BFS, 1U) !=
+                  solvable.cacheKey(Scenario::Algorithm::BFS, 1U));
+      BOOST_CHECK(!unsolvable.cachedSolution(cache, Scenario::Algorithm::BFS));
+      BOOST_CHECK(unsolvable.resultsByAlgorithm.size() == 1ULL);  // explored
+    }
+
+    const optional<SolutionsCache::Outcome> known{
+        cache.find(s1.cacheKey(Scenario::Algorithm::BFS, 1U))};
+    BOOST_REQUIRE(known);
+    BOOST_CHECK(known->solved);
+    ostringstream oss;
+    oss << s1.resultsByAlgorithm.at(Scenario::Algorithm::BFS);
+    BOOST_CHECK(known->results == oss.str());
+    ostringstream movesStream;
+    s1.writeInteractiveMoves(
+        movesStream, s1.resultsByAlgorithm.at(Scenario::Algorithm::BFS));
+    BOOST_CHECK(known->moves == movesStream.str());
+
+    // Outcomes stored in another format are ignored
+    BOOST_CHECK(s1.cacheKey(Scenario::Algorithm::BFS, 1U)
+                    .starts_with("Format: "s +
+                                 to_string(SolutionsCache::FormatVersion)));
+  }
+
+  {
+    // Evicting the least recently used outcomes above the capacity
+    const SolutionsCache cache{dir, 2ULL};
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    const auto outcome = [](const string& results) {
+      SolutionsCache::Outcome res;
+      res.results = results;
+      return res;
+    };
+    cache.store("a", outcome("A"));
+    cache.store("b", outcome("B"));
+    const auto now{fs::file_time_type::clock::now()};
+    fs::last_write_time(cache.fileOf("a"), now - 2h);
+    fs::last_write_time(cache.fileOf("b"), now - 1h);
+
+    BOOST_CHECK(cache.find("a")->results == "A");  // refreshes "a"
+    BOOST_CHECK(!cache.find("c"));
+    cache.store("c", outcome("C"));
+    BOOST_CHECK(!cache.find("b"));
+    BOOST_CHECK(cache.find("a")->results == "A");
+    BOOST_CHECK(cache.find("c")->results == "C");
+
+    // Files named after the FNV-1a digest of the keys
+    BOOST_CHECK(cache.fileOf("a").filename() == "af63dc4c8601ec8c.json");
+  }
+
+  fs::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_CASE(serveFrames) {
+  using namespace std;
+  using rc::Scenario, rc::serve;
+
+  const string scenarioText{R"({"ScenarioDescription": ["Farmer"],
+      "Entities" : [
+        {"Id": 0, "Name": "Farmer", "CanRow": "true"},
+        {"Id": 1, "Name": "Wolf"},
+        {"Id": 2, "Name": "Goat"},
+        {"Id": 3, "Name": "Cabbage"}
+        ],
+      "CrossingConstraints" : {
+        "RaftCapacity": 2
+        },
+      "BanksConstraints" : {
+        "ConfigurationsValidity" : false,
+        "Configurations": ["Wolf Goat", "Goat Cabbage"]
+        }
+      })"};
+  const string request{to_string(size(scenarioText)) + '\n' + scenarioText};
+
+  // Consumes a result frame and returns its exit code and output
+  const auto nextFrame = [](istream& is) {
+    int exitCode{};
+    size_t outputSize{};
+    BOOST_REQUIRE(is >> exitCode >> outputSize);
+    BOOST_REQUIRE(is.get() == '\n');
+    string output(outputSize, '\0');
+    BOOST_REQUIRE(is.read(data(output), (streamsize)outputSize));
+    return make_pair(exitCode, output);
+  };
+
+  {
+    // A plain request, a blank line, an interactive request and an invalid one
+    istringstream in{request + "\n\n" + to_string(size(scenarioText)) +
+                     " interactive\n" + scenarioText + "5\nabcde"};
+    stringstream out;
+    serve(in, out, nullptr, Scenario::Algorithm::BFS, 1U);
+
+    const auto [plainCode, plainOutput] = nextFrame(out);
+    BOOST_CHECK(plainCode == 0);
+    BOOST_CHECK(plainOutput.find("Found solution") != string::npos);
+
+    const auto [interactiveCode, interactiveOutput] = nextFrame(out);
+    BOOST_CHECK(interactiveCode == 0);
+    BOOST_CHECK(!interactiveOutput.empty());
+    BOOST_CHECK(interactiveOutput != plainOutput);
+
+    const auto [invalidCode, invalidOutput] = nextFrame(out);
+    BOOST_CHECK(invalidCode == -1);
+    BOOST_CHECK(!invalidOutput.empty());
+
+    BOOST_CHECK(out.peek() == char_traits<char>::eof());  // no more frames
+  }
+
+  const auto checkErrorFrame = [&nextFrame](istream& is, string_view header) {
+    const auto [errorCode, errorOutput] = nextFrame(is);
+    BOOST_CHECK(errorCode == -1);
+    BOOST_CHECK(errorOutput.find(header) != string::npos);
+  };
+
+  {
+    // A header with an unexpected mode and a too large scenario get error
+    // frames, while the scenarios following them are still served
+    istringstream in{to_string(size(scenarioText)) + " verbose\n" +
+                     scenarioText + " \t\n" + request + "1000000000\n"};
+    stringstream out;
+    serve(in, out, nullptr, Scenario::Algorithm::BFS, 1U);
+
+    checkErrorFrame(out, "verbose"sv);
+    BOOST_CHECK(nextFrame(out).first == 0);
+    checkErrorFrame(out, "1000000000"sv);
+
+    BOOST_CHECK(out.peek() == char_traits<char>::eof());  // no more frames
+  }
+
+  // Without a valid size in the header, the scenario cannot be skipped,
+  // so serving ends after a single error frame
+  for (const string_view header :
+       {"abc"sv, "-5"sv, "99999999999999999999999"sv}) {
+    istringstream in{string{header} + '\n' + scenarioText + '\n' + request};
+    stringstream out;
+    serve(in, out, nullptr, Scenario::Algorithm::BFS, 1U);
+
+    checkErrorFrame(out, header);
+    BOOST_CHECK(out.peek() == char_traits<char>::eof());  // no more frames
+  }
+
+  {
+    istringstream in{request + request.substr(0ULL, size(request) - 1ULL)};
+    stringstream out;
+    serve(in, out, nullptr, Scenario::Algorithm::BFS, 1U);
+    BOOST_CHECK(nextFrame(out).first == 0);
+
+    const auto [truncatedCode, truncatedOutput] = nextFrame(out);
+    BOOST_CHECK(truncatedCode == -1);
+    BOOST_CHECK(truncatedOutput.find("Truncated") != string::npos);
+    BOOST_CHECK(out.peek() == char_traits<char>::eof());  // no more frames
+  }
+}
+
+BOOST_AUTO_TEST_CASE(solveBatchRecords) {
+  using namespace std;
+  using rc::Scenario, rc::solveBatch;
+
+  fs::path dir{rc::projectFolder()};
+  BOOST_REQUIRE(!dir.empty());
+  BOOST_REQUIRE(exists(dir /= "Scenarios"));
+
+  const fs::path solvable{dir / "wolfGoatCabbage.json"},
+      missing{dir / "missingScenario.json"};
+  const vector<fs::path> files{solvable, missing, solvable};
+
+  // The nth record of `file` among the provided lines
+  const auto recordOf = [](const vector<string>& lines, const fs::path& file,
+                           size_t nth = 0ULL) {
+    const string fileEnd{file.filename().string() + "\","};
+    vector<string> matches;
+    ranges::copy_if(lines, back_inserter(matches), [&](const string& line) {
+      return line.starts_with("{\"file\": ") &&
+             line.find(fileEnd) != string::npos;
+    });
+    BOOST_REQUIRE(nth < size(matches));
+    return matches[nth];
+  };
+
+  const auto recordsOf = [](const string& out) {
+    vector<string> lines;
+    istringstream iss{out};
+    for (string line; getline(iss, line);)
+      lines.push_back(line);
+    return lines;
+  };
+
+  {
+    ostringstream out;
+    BOOST_CHECK(!solveBatch(files, out, 2U, Scenario::Algorithm::BFS, 1U));
+    const vector<string> lines{recordsOf(out.str())};
+    BOOST_REQUIRE(size(lines) == size(files));  // one record per file
+
+    for (size_t i{}; i < 2ULL; ++i) {
+      const string record{recordOf(lines, solvable, i)};
+      BOOST_CHECK(record.find("\"solved\": true") != string::npos);
+      BOOST_CHECK(record.find("\"solutionLength\": 7") != string::npos);
+      BOOST_CHECK(record.find("\"interrupted\"") == string::npos);
+      BOOST_CHECK(record.find("\"wallTimeMs\": ") != string::npos);
+      // The peak memory is process-wide, so not named as a per-scenario one
+      BOOST_CHECK(record.find("\"peakMemoryKiB\"") == string::npos);
+      BOOST_CHECK(record.ends_with("}"));
+    }
+    const string record{recordOf(lines, missing)};
+    BOOST_CHECK(record.find("\"error\": ") != string::npos);
+    BOOST_CHECK(record.find("\"solved\"") == string::npos);
+  }
+
+  {
+    // A DFS out of probes is reported as interrupted
+    ostringstream out;
+    BOOST_CHECK(!solveBatch({solvable}, out, 1U, Scenario::Algorithm::DFS, 1U,
+                            1ULL));
+    const vector<string> lines{recordsOf(out.str())};
+    BOOST_REQUIRE(size(lines) == 1ULL);
+    BOOST_CHECK(lines.front().find("\"solved\": false") != string::npos);
+    BOOST_CHECK(lines.front().find("\"interrupted\": true") != string::npos);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(checkAllScenarioFiles) {
   using namespace std;
 
@@ -1589,7 +2114,8 @@ BOOST_AUTO_TEST_CASE(checkAllScenarioFiles) {
   unsigned BFS_DFS_notableDiffs{};
 
   // Traverse the Scenarios folder and solve the puzzle from each json file
-  for (const auto& file : dir) {
+  for (const auto& entry : fs::directory_iterator{dir}) {
+    const fs::path& file{entry.path()};
     if (file.extension().string() != ".json")
       continue;
 
@@ -26,10 +26,12 @@ and the define by `#ifdef UNIT_TESTING`!"
 #include "transferredLoadExt.h"
 #include "util.h"
 
+#include <array>
 #include <cassert>
 #include <climits>
 #include <cmath>
 #include <concepts>
+#include <functional>
 #include <iterator>
 #include <numeric>
 #include <tuple>
@@ -107,6 +109,117 @@ template <class IfEntities>
   return returnedConfigs == expectedConfigs;
 }
 
+// Helper == between the options from configsForBank and expectedConfigs
+[[nodiscard]] bool operator==(
+    const std::vector<const MovingConfigOption*>& returnedConfigs,
+    const std::vector<std::set<unsigned> >& expectedConfigs) {
+  std::vector<const rc::ent::MovingEntities*> cfgs;
+  for (const MovingConfigOption* cfgOption : returnedConfigs)
+    cfgs.push_back(&cfgOption->get());
+  return cfgs == expectedConfigs;
+}
+
+/**
+Scenario with the first entitiesCount entities from a, b, c, d, e and f, which
+weigh 1 .. 6. `a` and `f` can always row, `b`, `c` and `e` never row and `d`
+rows only for even values of CrossingIndex. With reversibleMoves, `d` starts
+from the right bank and can always row instead, so the moves are reversible.
+The transfer constraints check only the capacity of the raft
+*/
+[[nodiscard]] rc::ScenarioDetails comparisonScenario(
+    unsigned entitiesCount,
+    unsigned capacity,
+    bool reversibleMoves = false) {
+  using namespace std;
+  using namespace rc;
+  using namespace rc::ent;
+  using namespace rc::cond;
+
+  assert(entitiesCount >= 4U && entitiesCount <= 6U);
+  auto pAe{make_unique<AllEntities>()};
+  try {
+    static constexpr array names{"a", "b", "c", "d", "e", "f"},
+        canRowExprs{"true", "false", "false",
+                    "if (%CrossingIndex% mod 2) in {0}", "false", "true"};
+    for (unsigned id{1U}; id <= entitiesCount; ++id) {
+      const bool reversedD{reversibleMoves && id == 4U};
+      *pAe += make_shared<const Entity>(
+          id, names[id - 1U], "", reversedD,
+          reversedD ? "true" : canRowExprs[id - 1U], (double)id);
+    }
+  } catch (...) {
+    BOOST_REQUIRE(false);  // Unexpected exception
+  }
+
+  ScenarioDetails d;
+  d.entities = shared_ptr<const AllEntities>(pAe.release());
+  d.capacity = capacity;
+  d.transferConstraints = make_unique<const TransferConstraints>(
+      grammar::ConstraintsVec{}, *d.entities, d.capacity, false);
+  return d;
+}
+
+/**
+Calls `check` for the scenario `d` from comparisonScenario and then for the
+variants obtained by adding successively these constraints:
+- b and c cannot be left alone on a bank
+- the raft supports at most the load maxLoads[i]
+*/
+void checkScenarioVariants(rc::ScenarioDetails& d,
+                           std::initializer_list<double> maxLoads,
+                           const std::function<void()>& check) {
+  using namespace std;
+  using namespace rc;
+  using namespace rc::cond;
+
+  try {
+    check();
+
+    auto pIc{make_unique<IdsConstraint>()};
+    pIc->addMandatoryId(2U).addMandatoryId(3U);
+    d.banksConstraints = make_unique<const ConfigConstraints>(
+        grammar::ConstraintsVec{shared_ptr<const IdsConstraint>(
+            pIc.release())},
+        *d.entities, false);
+    check();
+
+    for (const double maxLoad : maxLoads) {
+      d.maxLoad = maxLoad;
+      d.createTransferConstraintsExt();  // keep it after setting maxLoad
+      d.transferConstraints = make_unique<const TransferConstraints>(
+          grammar::ConstraintsVec{}, *d.entities, d.capacity, false,
+          *d.transferConstraintsExt);
+      check();
+    }
+  } catch (...) {
+    BOOST_CHECK(false);  // Unexpected exception
+  }
+}
+
+/// What the general BFS reports for a scenario, as reference for the other
+/// algorithms
+struct BfsOutcome {
+  rc::Scenario::Results results;
+  std::string solution;     ///< the found solution, if any
+  size_t solutionLength{};  ///< the length of the found solution, if any
+  bool solved{};
+};
+
+/// @return the outcome of the general BFS for the scenario `d`
+[[nodiscard]] BfsOutcome bfsOutcome(const rc::ScenarioDetails& d) {
+  BfsOutcome outcome;
+  Solver s{d, outcome.results};
+  std::unique_ptr<const rc::sol::IState> initSt{d.createInitialState(s.SymTb)};
+  s.targetLeftBank =
+      std::make_unique<const rc::ent::BankEntities>(initSt->rightBank());
+  outcome.solved = s.bfsExplore(std::move(initSt));
+  if (outcome.solved) {
+    outcome.solution = s.steps->toString();
+    outcome.solutionLength = s.steps->length();
+  }
+  return outcome;
+}
+
 BOOST_AUTO_TEST_SUITE(solver, *boost::unit_test::tolerance(rc::Eps))
 
 BOOST_AUTO_TEST_CASE(generateCombinations_usecases) {
@@ -515,7 +628,7 @@ BOOST_AUTO_TEST_CASE(movingConfigsManager_usecases) {
 
   sd.capacity = (unsigned)entsCount - 1U;
 
-  vector<const MovingEntities*> configsForABank;
+  vector<const MovingConfigOption*> configsForABank;
 
   try {
     {
@@ -543,6 +656,13 @@ BOOST_AUTO_TEST_CASE(movingConfigsManager_usecases) {
                  == investigatedRaftCombs);
       BOOST_TEST(investigatedRaftCombs == (double)size(mcm.allConfigs));
 
+      // Each configuration is a flyweight, found by its address
+      for (const MovingConfigOption& cfgOption : mcm.allConfigs)
+        BOOST_CHECK(mcm.sharedConfig(cfgOption.get()) == cfgOption.shared());
+      BOOST_CHECK_THROW(ignore = mcm.sharedConfig(MovingEntities{
+                            sd.entities, mcm.allConfigs[0].get().ids()}),
+                        out_of_range);
+
       // None of 1,3,5 can row
       mcm.configsForBank(be = {1U, 3U, 5U}, configsForABank, true);
       BOOST_CHECK(configsForABank.empty());
@@ -564,10 +684,10 @@ BOOST_AUTO_TEST_CASE(movingConfigsManager_usecases) {
             ent::MovingEntities{sd.entities, {1U, 3U, 5U}}, emptySt));
 
         // allow confirmed configurations
-        for (const ent::MovingEntities* cfg : configsForABank) {
-          if (cfg)
-            BOOST_TEST_CONTEXT("for raft cfg: `" << *cfg << '`') {
-              BOOST_CHECK(validator->validate(*cfg, emptySt));
+        for (const MovingConfigOption* cfgOption : configsForABank) {
+          if (cfgOption)
+            BOOST_TEST_CONTEXT("for raft cfg: `" << cfgOption->get() << '`') {
+              BOOST_CHECK(validator->validate(cfgOption->get(), emptySt));
             }
         }
       }
@@ -714,10 +834,10 @@ BOOST_AUTO_TEST_CASE(movingConfigsManager_usecases) {
             InitialSymbolsTable()));
 
         // allow confirmed configurations
-        for (const ent::MovingEntities* cfg : configsForABank) {
-          if (cfg)
-            BOOST_TEST_CONTEXT("for raft cfg: `" << *cfg << '`') {
-              BOOST_CHECK(validator->validate(*cfg, emptySt));
+        for (const MovingConfigOption* cfgOption : configsForABank) {
+          if (cfgOption)
+            BOOST_TEST_CONTEXT("for raft cfg: `" << cfgOption->get() << '`') {
+              BOOST_CHECK(validator->validate(cfgOption->get(), emptySt));
             }
         }
       }
@@ -730,6 +850,215 @@ BOOST_AUTO_TEST_CASE(movingConfigsManager_usecases) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(movingConfigsSubsetIndex_usecases) {
+  using namespace std;
+  using namespace rc;
+  using namespace rc::ent;
+  using namespace rc::cond;
+
+  const SymbolsTable emptySt;
+  auto pAe{make_unique<AllEntities>()};
+  AllEntities& ae{*pAe};
+  ScenarioDetails sd;
+  sd.entities = shared_ptr<const AllEntities>(pAe.release());
+
+  try {  // e1, e3 and e5 don't row
+    for (unsigned id{}; id < 7U; ++id)
+      ae += make_shared<const Entity>(id, "e" + to_string(id), "t0", false,
+                                      (id % 2U) ? "false" : "true", 1.);
+  } catch (...) {
+    BOOST_REQUIRE(false);  // Unexpected exception
+  }
+
+  sd.capacity = 3U;
+  sd.transferConstraints = make_unique<const TransferConstraints>(
+      grammar::ConstraintsVec{}, *sd.entities, sd.capacity, false);
+
+  try {
+    const MovingConfigsManager mcm{sd, emptySt};
+    BOOST_REQUIRE(size(mcm.subsetTries) == 1ULL);
+
+    // The options know their index
+    for (unsigned idx{}; idx < (unsigned)size(mcm.allConfigs); ++idx)
+      BOOST_CHECK(mcm.allConfigs[idx].index() == idx);
+
+    // The trie must find exactly the configurations included in each bank,
+    // in the order in which they appear within allConfigs
+    vector<const MovingConfigOption*> configsForABank, expectedConfigs;
+    const IdsMask fullMask{sd.entities->fullMask()};
+    for (IdsMask bankMask{}; bankMask <= fullMask; ++bankMask) {
+      const BankEntities be{sd.entities, bankMask};
+      expectedConfigs.clear();
+      for (const MovingConfigOption& cfgOption : mcm.allConfigs)
+        if (!(*cfgOption.mask() & ~bankMask))
+          expectedConfigs.push_back(&cfgOption);
+
+      BOOST_TEST_CONTEXT("for bank: `" << be << '`') {
+        mcm.configsForBank(be, configsForABank, false);
+        BOOST_CHECK(configsForABank == expectedConfigs);
+
+        mcm.configsForBank(be, configsForABank, true);
+        ranges::reverse(expectedConfigs);
+        BOOST_CHECK(configsForABank == expectedConfigs);
+      }
+    }
+  } catch (...) {
+    BOOST_CHECK(false);  // Unexpected exception
+  }
+}
+
+BOOST_AUTO_TEST_CASE(movingConfigsByResidue_usecases) {
+  using namespace std;
+  using namespace rc;
+  using namespace rc::ent;
+  using namespace rc::cond;
+
+  auto pAe{make_unique<AllEntities>()};
+  AllEntities& ae{*pAe};
+  ScenarioDetails sd;
+  sd.entities = shared_ptr<const AllEntities>(pAe.release());
+
+  try {  // e0 never rows; e1 and e2 row periodically; the others always row
+    ae += make_shared<const Entity>(0U, "e0", "t0", false, "false", 1.);
+    ae += make_shared<const Entity>(1U, "e1", "t0", false,
+                                    "if (%CrossingIndex% mod 2) in {1}", 1.);
+    ae += make_shared<const Entity>(
+        2U, "e2", "t0", false,
+        "if (add(%CrossingIndex%, 1) mod 3) in {1 .. 2}", 1.);
+    for (unsigned id{3U}; id < 5U; ++id)
+      ae += make_shared<const Entity>(id, "e" + to_string(id), "t0", false,
+                                      "true", 1.);
+  } catch (...) {
+    BOOST_REQUIRE(false);  // Unexpected exception
+  }
+
+  // Tabulated row-abilities
+  BOOST_CHECK(ae[0U]->canRowByCrossingIndex().empty());
+  BOOST_CHECK(ae[1U]->canRowByCrossingIndex() == vector<bool>({false, true}));
+  BOOST_CHECK(ae[2U]->canRowByCrossingIndex() ==
+              vector<bool>({true, true, false}));
+  BOOST_CHECK(ae[3U]->canRowByCrossingIndex().empty());
+  BOOST_CHECK(Entity(9U, "e9", "t0", false, "if %CrossingIndex% in {1 .. 3}")
+                  .canRowByCrossingIndex()
+                  .empty());  // not periodic
+
+  sd.capacity = 2U;
+  sd.transferConstraints = make_unique<const TransferConstraints>(
+      grammar::ConstraintsVec{}, *sd.entities, sd.capacity, false);
+
+  try {
+    const MovingConfigsManager mcm{sd, SymbolsTable{{"CrossingIndex", 1.}}};
+    BOOST_REQUIRE(mcm.crossingIndexPeriod == 6U);
+    BOOST_REQUIRE(size(mcm.configsByResidue) == 7ULL);
+    BOOST_REQUIRE(size(mcm.subsetTries) == 7ULL);
+
+    // Each group keeps exactly the configurations with some entity able to
+    // row for the given CrossingIndex
+    vector<const MovingConfigOption*> configsForABank, expectedConfigs;
+    const IdsMask fullMask{sd.entities->fullMask()};
+    for (unsigned crossingIdx{1U}; crossingIdx <= 12U; ++crossingIdx) {
+      const SymbolsTable st{{"CrossingIndex", (double)crossingIdx}};
+      for (IdsMask bankMask{}; bankMask <= fullMask; ++bankMask) {
+        const BankEntities be{sd.entities, bankMask};
+        expectedConfigs.clear();
+        for (const MovingConfigOption& cfgOption : mcm.allConfigs)
+          if (!(*cfgOption.mask() & ~bankMask) &&
+              cfgOption.get().anyRowCapableEnts(st))
+            expectedConfigs.push_back(&cfgOption);
+
+        BOOST_TEST_CONTEXT("for CrossingIndex " << crossingIdx << " and bank: `"
+                                                << be << '`') {
+          mcm.configsForBank(be, configsForABank, false, st);
+          BOOST_CHECK(configsForABank == expectedConfigs);
+        }
+      }
+    }
+
+    // Without CrossingIndex, only the entities which always row can row
+    const BankEntities be{sd.entities, fullMask};
+    mcm.configsForBank(be, configsForABank, false, SymbolsTable{});
+    BOOST_CHECK(!configsForABank.empty());
+    for (const MovingConfigOption* cfgOption : configsForABank)
+      BOOST_CHECK(cfgOption->get().ids().contains(3U) ||
+                  cfgOption->get().ids().contains(4U));
+  } catch (...) {
+    BOOST_CHECK(false);  // Unexpected exception
+  }
+}
+
+BOOST_AUTO_TEST_CASE(movingConfigsLoadsTable_usecases) {
+  using namespace std;
+  using namespace rc;
+  using namespace rc::ent;
+  using namespace rc::cond;
+
+  auto pAe{make_unique<AllEntities>()};
+  AllEntities& ae{*pAe};
+  ScenarioDetails sd;
+  sd.entities = shared_ptr<const AllEntities>(pAe.release());
+
+  try {
+    for (unsigned id{}; id < 5U; ++id)
+      ae += make_shared<const Entity>(id, "e" + to_string(id), "t0", false,
+                                      "true", 1. + id);
+  } catch (...) {
+    BOOST_REQUIRE(false);  // Unexpected exception
+  }
+
+  sd.capacity = 2U;
+  sd.transferConstraints = make_unique<const TransferConstraints>(
+      grammar::ConstraintsVec{}, *sd.entities, sd.capacity, false);
+  sd.allowedLoads = grammar::parseAllowedLoadsExpr(
+      "add(%PreviousRaftLoad%, -1) .. add(%PreviousRaftLoad%, 1)");
+  BOOST_REQUIRE(sd.allowedLoads);
+
+  try {
+    const MovingConfigsManager mcm{sd, InitialSymbolsTable()};
+    BOOST_REQUIRE(mcm.allowedLoadsProgram);
+    BOOST_REQUIRE(mcm.loadsDependOnPrevLoad);
+    BOOST_CHECK(mcm.loads == vector<double>({1., 2., 3., 4., 5., 6., 7., 8.,
+                                             9.}));  // loads from 1 to 9
+    BOOST_CHECK(size(mcm.admissibleLoads) == size(mcm.loads) + 1ULL);
+
+    // The table must accept the same configurations as the validator
+    const shared_ptr<const IContextValidator> validator{
+        sd.createTransferValidator()};
+    vector<SymbolsTable> contexts{SymbolsTable{{"CrossingIndex", 1.}},
+                                  SymbolsTable{{"CrossingIndex", 3.},
+                                               {"PreviousRaftLoad", 4.5}}};
+    for (double prevLoad{1.}; prevLoad < 10.; ++prevLoad)
+      contexts.push_back(SymbolsTable{{"CrossingIndex", 3.},
+                                      {"PreviousRaftLoad", prevLoad}});
+
+    vector<const MovingConfigOption*> configsForABank, expectedConfigs;
+    const IdsMask fullMask{sd.entities->fullMask()};
+    for (const SymbolsTable& st : contexts) {
+      for (IdsMask bankMask{1ULL}; bankMask <= fullMask; ++bankMask) {
+        const BankEntities be{sd.entities, bankMask};
+        expectedConfigs.clear();
+        for (const MovingConfigOption& cfgOption : mcm.allConfigs)
+          if (!(*cfgOption.mask() & ~bankMask) &&
+              validator->validate(cfgOption.get(), st))
+            expectedConfigs.push_back(&cfgOption);
+
+        BOOST_TEST_CONTEXT("for bank: `" << be << '`') {
+          mcm.configsForBank(be, configsForABank, false, st);
+          BOOST_CHECK(configsForABank == expectedConfigs);
+        }
+      }
+    }
+
+    // PreviousRaftLoad must appear after the initial state
+    BOOST_CHECK_THROW(
+        mcm.configsForBank(BankEntities{sd.entities, fullMask},
+                           configsForABank, false,
+                           SymbolsTable{{"CrossingIndex", 3.}}),
+        out_of_range);
+  } catch (...) {
+    BOOST_CHECK(false);  // Unexpected exception
+  }
+}
+
 BOOST_AUTO_TEST_CASE(algorithmStates_usecases) {
   using namespace std;
   using namespace rc;
@@ -789,6 +1118,32 @@ BOOST_AUTO_TEST_CASE(algorithmStates_usecases) {
   MovingEntities moved{
       spAe, {2U, 3U}, make_unique<TotalLoadExt>(spAe, maxLoad)};
 
+  {
+    // The durations are resolved from the first matching item
+    BOOST_CHECK(info.crossingDurationOf(BankEntities{spAe, {1U, 3U}}) ==
+                4321U);  // 1 *
+    BOOST_CHECK(!info.crossingDurationOf(BankEntities{spAe, {2U, 3U}}));
+
+    // CrossingDurationExt keeps the duration of the first group and its copies
+    MovingEntities raft{spAe, {1U, 3U}, make_unique<CrossingDurationExt>(
+                                            spAe, 4321U)};
+    const MovingEntities raftCopy{raft};
+    const CrossingDurationExt& cde{
+        dynamic_cast<const CrossingDurationExt&>(*raft.getExtension())};
+    BOOST_CHECK(cde.crossingDuration() == 4321U);
+    BOOST_CHECK(
+        dynamic_cast<const CrossingDurationExt&>(*raftCopy.getExtension())
+            .crossingDuration() == 4321U);
+
+    raft -= 3U;  // the duration is no longer known
+    BOOST_CHECK(!cde.crossingDuration());
+
+    MovingEntities raft2{raftCopy};
+    raft2 = {2U, 3U};  // a different group forgets the duration
+    BOOST_CHECK(!dynamic_cast<const CrossingDurationExt&>(*raft2.getExtension())
+                     .crossingDuration());
+  }
+
   {
     BankEntities left5{left}, right5{right};
     left5 -= moved;
@@ -1079,6 +1434,171 @@ BOOST_AUTO_TEST_CASE(algorithmStates_usecases) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(examinedStates_usecases) {
+  using namespace std;
+  using namespace rc;
+  using namespace rc::ent;
+  using namespace rc::sol;
+
+  auto pAe{make_unique<AllEntities>()};
+  AllEntities& ae{*pAe};
+  auto spAe{shared_ptr<const AllEntities>(pAe.release())};
+
+  try {
+    ae += make_shared<const Entity>(1U, "e1", "", false, "true");
+    ae += make_shared<const Entity>(2U, "e2");
+    ae += make_shared<const Entity>(3U, "e3");
+  } catch (...) {
+    BOOST_REQUIRE(false);  // Unexpected exception
+  }
+
+  ScenarioDetails info;
+  info.entities = spAe;
+
+  BankEntities right{spAe}, left{~right};
+  BankEntities left2{spAe, {1U}}, right2{~left2};
+  BankEntities left3{spAe, {2U, 3U}}, right3{~left3};
+
+  const auto timeExt = [&info](unsigned t) {
+    return make_shared<const TimeStateExt>(t, info);
+  };
+
+  State s{left, right, true, timeExt(10U)},
+      sLater{left, right, true, timeExt(11U)},
+      sEarlier{left, right, true, timeExt(9U)},
+      sOtherDir{left, right, false, timeExt(10U)},
+      s2{left2, right2, true, timeExt(10U)},
+      s3{left3, right3, true, timeExt(10U)};
+
+  ExaminedStates es;
+  BOOST_CHECK(!es.size());
+  BOOST_CHECK(!es.cover(s));
+
+  es.add(s.clone());
+  BOOST_CHECK(es.size() == 1ULL);
+  BOOST_CHECK(es.cover(s));
+  BOOST_CHECK(es.cover(sLater));     // s occurred earlier
+  BOOST_CHECK(!es.cover(sEarlier));  // sEarlier is better than s
+  BOOST_CHECK(!es.cover(sOtherDir));  // direction mismatch
+  BOOST_CHECK(!es.cover(s2));         // different bank configs
+  BOOST_CHECK(!es.cover(s3));         // different bank configs
+
+  es.add(sOtherDir.clone());
+  es.add(s2.clone());
+  es.add(s3.clone());
+  BOOST_CHECK(es.size() == 4ULL);
+  BOOST_CHECK(es.cover(sOtherDir) && es.cover(s2) && es.cover(s3));
+
+  // The added states are shared, not copied
+  const shared_ptr<const IState> sharedEarlier{sEarlier.clone()};
+  es.add(sharedEarlier);  // replaces the dominated s
+  BOOST_CHECK(sharedEarlier.use_count() == 2L);
+  BOOST_CHECK(es.size() == 4ULL);
+  BOOST_CHECK(es.cover(s));
+  BOOST_CHECK(es.cover(sEarlier));
+
+#ifndef NDEBUG
+  es.checkNoRedundancy();
+#endif  // NDEBUG
+}
+
+BOOST_AUTO_TEST_CASE(interchangeableEntities_usecases) {
+  using namespace std;
+  using namespace rc;
+  using namespace rc::ent;
+  using namespace rc::cond;
+  using namespace rc::sol;
+
+  // Allows comparing the search with and without interchangeable entities
+  const auto entitiesWithTypes = [](const array<string, 5ULL>& types) {
+    auto pAe{make_unique<AllEntities>()};
+    try {
+      *pAe += make_shared<const Entity>(1U, "a", "", false, "true");
+      *pAe += make_shared<const Entity>(2U, "b", types[0ULL]);
+      *pAe += make_shared<const Entity>(3U, "c", types[1ULL]);
+      *pAe += make_shared<const Entity>(4U, "d", types[2ULL]);
+      *pAe += make_shared<const Entity>(5U, "e", types[3ULL], false, "true");
+      *pAe += make_shared<const Entity>(6U, "f", types[4ULL], false, "true");
+    } catch (...) {
+      BOOST_REQUIRE(false);  // Unexpected exception
+    }
+    return shared_ptr<const AllEntities>(pAe.release());
+  };
+
+  ScenarioDetails d;
+  d.entities = entitiesWithTypes({"x", "x", "x", "y", "y"});
+  d.capacity = 2U;
+  d.transferConstraints = make_unique<const TransferConstraints>(
+      grammar::ConstraintsVec{}, *d.entities, d.capacity, false);
+
+  const AllEntities& ae{*d.entities};
+  const IdsMask bcd{ae.maskOf(2U) | ae.maskOf(3U) | ae.maskOf(4U)},
+      ef{ae.maskOf(5U) | ae.maskOf(6U)};
+  vector<IdsMask> groups{d.interchangeableEntities()};
+  ranges::sort(groups);
+  BOOST_CHECK(groups == (vector<IdsMask>{min(bcd, ef), max(bcd, ef)}));
+
+  const InterchangeableEntities ie{groups};
+  BOOST_CHECK(!ie.empty());
+  BOOST_CHECK(ie.canonical(ae.maskOf(1U)) == ae.maskOf(1U));
+  BOOST_CHECK(ie.canonical(ae.maskOf(4U)) == ae.maskOf(2U));
+  BOOST_CHECK(ie.canonical(ae.maskOf(3U) | ae.maskOf(4U) | ae.maskOf(6U)) ==
+              (ae.maskOf(2U) | ae.maskOf(3U) | ae.maskOf(5U)));
+
+  // e and f move the same way, so only one of them is proposed
+  vector<const MovingConfigOption*> cfgs;
+  const MovingConfigOption e{MovingEntities{d.entities, {5U}}},
+      f{MovingEntities{d.entities, {6U}}},
+      ae_{MovingEntities{d.entities, {1U, 5U}}},
+      af{MovingEntities{d.entities, {1U, 6U}}};
+  cfgs = {&e, &ae_, &f, &af};
+  ie.dropEquivalentConfigs(cfgs);
+  BOOST_CHECK(cfgs == (vector<const MovingConfigOption*>{&e, &ae_}));
+
+  // Equivalent states are examined only once
+  ExaminedStates es{ie};
+  BankEntities left{d.entities, {1U, 2U, 5U}}, right{~left},
+      left2{d.entities, {1U, 4U, 6U}}, right2{~left2},
+      left3{d.entities, {1U, 2U, 3U}}, right3{~left3};
+  es.add(State{left, right, true}.clone());
+  BOOST_CHECK(es.cover(State{left2, right2, true}));
+  BOOST_CHECK(!es.cover(State{left2, right2, false}));
+  BOOST_CHECK(!es.cover(State{left3, right3, true}));
+
+  // Mentioning an entity individually excludes it from its group
+  auto pIc{make_unique<IdsConstraint>()};
+  pIc->addMandatoryId(4U).addMandatoryId(5U);
+  d.banksConstraints = make_unique<const ConfigConstraints>(
+      grammar::ConstraintsVec{shared_ptr<const IdsConstraint>(pIc.release())},
+      *d.entities, false);
+  BOOST_CHECK(d.interchangeableEntities() ==
+              vector<IdsMask>{ae.maskOf(2U) | ae.maskOf(3U)});
+
+  // Same solution length, but no more investigated states
+  d.banksConstraints.reset();
+  ScenarioDetails dDistinct;
+  dDistinct.entities = entitiesWithTypes({"x", "y", "z", "t", "u"});
+  dDistinct.capacity = d.capacity;
+  dDistinct.transferConstraints = make_unique<const TransferConstraints>(
+      grammar::ConstraintsVec{}, *dDistinct.entities, dDistinct.capacity,
+      false);
+  BOOST_REQUIRE(dDistinct.interchangeableEntities().empty());
+  for (const Scenario::Algorithm algorithm :
+       {Scenario::Algorithm::BFS, Scenario::Algorithm::DFS,
+        Scenario::Algorithm::AStar}) {
+    Scenario::Results o, oDistinct;
+    Solver{d, o}.run(algorithm);
+    Solver{dDistinct, oDistinct}.run(algorithm);
+    BOOST_REQUIRE(o.attempt && oDistinct.attempt);
+    BOOST_CHECK(o.attempt->isSolution() && oDistinct.attempt->isSolution());
+    if (algorithm != Scenario::Algorithm::DFS)
+      BOOST_CHECK(o.attempt->length() == oDistinct.attempt->length());
+    BOOST_CHECK(o.investigatedStates <= oDistinct.investigatedStates);
+    if (algorithm == Scenario::Algorithm::BFS)  // explores all short paths
+      BOOST_CHECK(o.investigatedStates < oDistinct.investigatedStates);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(algorithmMove_usecases) {
   using namespace std;
   using namespace rc;
@@ -1116,6 +1636,17 @@ BOOST_AUTO_TEST_CASE(algorithmMove_usecases) {
     BOOST_CHECK(me == m.movedEntities());
     BOOST_CHECK(m.resultedState()->handledBy(*clonedS));
     BOOST_CHECK(clonedS->handledBy(*m.resultedState()));
+
+    // Copies of a move share its moved entities
+    const Move copied{m}, copiedFromIMove{(const IMove&)m};
+    BOOST_CHECK(&copied.movedEntities() == &m.movedEntities());
+    BOOST_CHECK(&copiedFromIMove.movedEntities() == &m.movedEntities());
+
+    // Moves share the flyweights of the configurations
+    const shared_ptr<const MovingEntities> spMe{
+        make_shared<const MovingEntities>(me)};
+    const Move mShared(spMe, clonedS->next(*spMe), 0U);
+    BOOST_CHECK(&mShared.movedEntities() == spMe.get());
   } catch (...) {
     BOOST_CHECK(false);  // Unexpected exception
   }
@@ -1432,6 +1963,449 @@ BOOST_AUTO_TEST_CASE(solvingVariousScenarios) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(denseBfs_usecases) {
+  using namespace std;
+  using namespace rc;
+  using namespace rc::ent;
+  using namespace rc::cond;
+  using namespace rc::sol;
+
+  ScenarioDetails d{comparisonScenario(4U, 2U)};
+
+  // The dense BFS must produce the same results as the general BFS
+  const auto checkSameAsBfs = [&d] {
+    Scenario::Results oDense;
+    Solver sDense{d, oDense};
+    BOOST_REQUIRE(
+        sDense.denseBfsApplicable(*d.createInitialState(sDense.SymTb)));
+    sDense.run(true);
+
+    const BfsOutcome bfs{bfsOutcome(d)};
+    BOOST_REQUIRE(oDense.attempt);
+    BOOST_CHECK(oDense.attempt->isSolution() == bfs.solved);
+    if (bfs.solved)
+      BOOST_CHECK(oDense.attempt->toString() == bfs.solution);
+    BOOST_CHECK(oDense.investigatedStates == bfs.results.investigatedStates);
+    BOOST_CHECK(oDense.longestInvestigatedPath ==
+                bfs.results.longestInvestigatedPath);
+    BOOST_CHECK(size(oDense.closestToTargetLeftBank) ==
+                size(bfs.results.closestToTargetLeftBank));
+
+    // The dense A* must find solutions as short as the general A*
+    Scenario::Results oDenseAStar, oAStar;
+    Solver sDenseAStar{d, oDenseAStar}, sAStar{d, oAStar};
+    sDenseAStar.run(Scenario::Algorithm::AStar);
+    unique_ptr<const IState> initSt{d.createInitialState(sAStar.SymTb)};
+    sAStar.targetLeftBank =
+        make_unique<const BankEntities>(initSt->rightBank());
+    const bool solvedAStar{sAStar.aStarExplore(std::move(initSt))};
+    BOOST_REQUIRE(oDenseAStar.attempt);
+    BOOST_CHECK(oDenseAStar.attempt->isSolution() == solvedAStar);
+    if (solvedAStar)
+      BOOST_CHECK(oDenseAStar.attempt->length() == sAStar.steps->length());
+
+    // The dense uniform-cost search must find solutions as fast as the
+    // general one
+    Scenario::Results oDenseUcs, oUcs;
+    Solver sDenseUcs{d, oDenseUcs}, sUcs{d, oUcs};
+    initSt = d.createInitialState(sUcs.SymTb);
+    if (!AbsStateExt::selectExt<TimeStateExt>(initSt->getExtension().get()))
+      return;
+    sDenseUcs.run(Scenario::Algorithm::UniformCost);
+    sUcs.targetLeftBank = make_unique<const BankEntities>(initSt->rightBank());
+    const bool solvedUcs{sUcs.uniformCostExplore(std::move(initSt))};
+    BOOST_REQUIRE(oDenseUcs.attempt);
+    BOOST_CHECK(oDenseUcs.attempt->isSolution() == solvedUcs);
+    if (solvedUcs)
+      BOOST_CHECK(
+          Solver::timeOf(*oDenseUcs.attempt->lastMove().resultedState()) ==
+          Solver::timeOf(*sUcs.steps->lastMove().resultedState()));
+  };
+
+  // No solution when the raft supports at most a load of 3, unlike for 5
+  checkScenarioVariants(d, {3., 5.}, checkSameAsBfs);
+
+  try {
+    // Time-aware states: crossings of `a` with someone take 2 time units,
+    // the rest take 3
+    auto pIcA{make_unique<IdsConstraint>()},
+        pIcOne{make_unique<IdsConstraint>()},
+        pIcTwo{make_unique<IdsConstraint>()};
+    pIcA->addMandatoryId(1U).addUnspecifiedMandatory();  // 1 *
+    pIcOne->addUnspecifiedMandatory();                    // *
+    pIcTwo->addUnspecifiedMandatory().addUnspecifiedMandatory();  // * *
+    grammar::ConfigurationsTransferDurationInitType ctditA, ctditRest;
+    ctditA.setDuration(2U).setConstraints(
+        {shared_ptr<const IdsConstraint>(pIcA.release())});
+    ctditRest.setDuration(3U).setConstraints(
+        {shared_ptr<const IdsConstraint>(pIcOne.release()),
+         shared_ptr<const IdsConstraint>(pIcTwo.release())});
+    d.ctdItems.emplace_back(std::move(ctditA), *d.entities, d.capacity,
+                            *d.transferConstraintsExt);
+    d.ctdItems.emplace_back(std::move(ctditRest), *d.entities, d.capacity,
+                            *d.transferConstraintsExt);
+    for (const unsigned maxDuration : {100U, 11U, 9U}) {
+      d.maxDuration = maxDuration;
+      checkSameAsBfs();
+    }
+
+    // States depending also on the previous raft load
+    d.allowedLoads = grammar::parseAllowedLoadsExpr(
+        "add(%PreviousRaftLoad%, -2) .. add(%PreviousRaftLoad%, 3)");
+    BOOST_REQUIRE(d.allowedLoads);
+    for (const unsigned maxDuration : {100U, 11U}) {
+      d.maxDuration = maxDuration;
+      checkSameAsBfs();
+    }
+
+    d.maxDuration = UINT_MAX;
+    checkSameAsBfs();
+  } catch (...) {
+    BOOST_CHECK(false);  // Unexpected exception
+  }
+}
+
+BOOST_AUTO_TEST_CASE(parallelBfs_usecases) {
+  using namespace std;
+  using namespace rc;
+  using namespace rc::ent;
+  using namespace rc::sol;
+
+  ScenarioDetails d{comparisonScenario(6U, 3U)};
+
+  // The parallel and the dense BFS must produce the same results as the
+  // sequential BFS, no matter the number of threads
+  const auto checkSameAsBfs = [&d] {
+    const BfsOutcome bfs{bfsOutcome(d)};
+    for (const unsigned threadsCount : {1U, 2U, 3U, 8U}) {
+      Scenario::Results oPar;
+      Solver sPar{d, oPar, threadsCount};
+      unique_ptr<const IState> initSt{d.createInitialState(sPar.SymTb)};
+      sPar.targetLeftBank =
+          make_unique<const BankEntities>(initSt->rightBank());
+      BOOST_CHECK(sPar.parallelBfsExplore(std::move(initSt)) == bfs.solved);
+      if (bfs.solved)
+        BOOST_CHECK(sPar.steps->toString() == bfs.solution);
+      BOOST_CHECK(oPar.investigatedStates == bfs.results.investigatedStates);
+      BOOST_CHECK(oPar.longestInvestigatedPath ==
+                  bfs.results.longestInvestigatedPath);
+      BOOST_CHECK(size(oPar.closestToTargetLeftBank) ==
+                  size(bfs.results.closestToTargetLeftBank));
+
+      // `run` picks the dense BFS, which expands its larger levels in parallel
+      Scenario::Results oRun;
+      Solver sRun{d, oRun, threadsCount};
+      BOOST_REQUIRE(sRun.denseBfsApplicable(*d.createInitialState(sRun.SymTb)));
+      sRun.run(true);
+      BOOST_CHECK((bool)sRun.workers == (threadsCount > 1U));
+      BOOST_REQUIRE(oRun.attempt);
+      BOOST_CHECK(oRun.attempt->isSolution() == bfs.solved);
+      if (bfs.solved)
+        BOOST_CHECK(oRun.attempt->toString() == bfs.solution);
+      BOOST_CHECK(oRun.investigatedStates == bfs.results.investigatedStates);
+      BOOST_CHECK(oRun.longestInvestigatedPath ==
+                  bfs.results.longestInvestigatedPath);
+      BOOST_CHECK(size(oRun.closestToTargetLeftBank) ==
+                  size(bfs.results.closestToTargetLeftBank));
+    }
+  };
+
+  // Some raft configurations are too heavy for the max load
+  checkScenarioVariants(d, {8.}, checkSameAsBfs);
+}
+
+BOOST_AUTO_TEST_CASE(parallelDfs_usecases) {
+  using namespace std;
+  using namespace rc;
+  using namespace rc::ent;
+  using namespace rc::cond;
+  using namespace rc::sol;
+
+  ScenarioDetails d{comparisonScenario(6U, 3U)};
+
+  // The parallel DFS must find a solution whenever the BFS finds one.
+  // The found solution might depend on the scheduling of the threads
+  const auto checkSolvedLikeBfs = [&d] {
+    const BfsOutcome bfs{bfsOutcome(d)};
+    for (const unsigned threadsCount : {2U, 3U, 8U}) {
+      Scenario::Results oPar;
+      Solver sPar{d, oPar, threadsCount};
+      sPar.run(false);  // DFS
+      BOOST_REQUIRE(oPar.attempt);
+      BOOST_CHECK(oPar.attempt->isSolution() == bfs.solved);
+      if (bfs.solved)
+        BOOST_CHECK(oPar.attempt->length() >= bfs.solutionLength);
+      BOOST_CHECK(oPar.investigatedStates > 0ULL);
+    }
+  };
+
+  // Some raft configurations are too heavy for the max load
+  checkScenarioVariants(d, {8.}, checkSolvedLikeBfs);
+
+  // Without a solution, the parallel DFS examines every reachable state
+  // exactly once, like the sequential DFS, while several workers explore
+  // tasks simultaneously. The heavy entity can't cross the river
+  auto pAe2{make_unique<AllEntities>()};
+  try {
+    for (unsigned id{1U}; id <= 11U; ++id)
+      *pAe2 += make_shared<const Entity>(id, "e"s + to_string(id),
+                                         "t"s + to_string(id), false,
+                                         id <= 2U ? "true" : "false",
+                                         id < 11U ? 1. : 100.);
+  } catch (...) {
+    BOOST_REQUIRE(false);  // Unexpected exception
+  }
+  ScenarioDetails d2;
+  d2.entities = shared_ptr<const AllEntities>(pAe2.release());
+  d2.capacity = 3U;
+  d2.maxLoad = 50.;
+  d2.createTransferConstraintsExt();  // keep it after setting maxLoad
+  d2.transferConstraints = make_unique<const TransferConstraints>(
+      grammar::ConstraintsVec{}, *d2.entities, d2.capacity, false,
+      *d2.transferConstraintsExt);
+
+  Scenario::Results oSeq;
+  Solver{d2, oSeq}.run(false);  // DFS
+  BOOST_REQUIRE(oSeq.attempt && !oSeq.attempt->isSolution());
+  for (const unsigned threadsCount : {2U, 4U, 8U}) {
+    Scenario::Results oPar;
+    Solver sPar{d2, oPar, threadsCount};
+    sPar.run(false);  // DFS
+    BOOST_REQUIRE(oPar.attempt);
+    BOOST_CHECK(!oPar.attempt->isSolution());
+    BOOST_CHECK(oPar.investigatedStates == oSeq.investigatedStates);
+    BOOST_CHECK(oPar.closestToTargetLeftBank.size() ==
+                oSeq.closestToTargetLeftBank.size());
+    BOOST_CHECK(sPar.dfsMostBusyWorkers > 1U);
+  }
+
+  // An idle worker takes over the second half of the untried configurations
+  // from the shallowest frame of a busy task, with the path leading there
+  Scenario::Results oSplit;
+  Solver sSplit{d2, oSplit};
+  unique_ptr<const IState> initSt{d2.createInitialState(sSplit.SymTb)};
+  sSplit.targetLeftBank = make_unique<const BankEntities>(initSt->rightBank());
+  sSplit.dfsStart(std::move(initSt));
+  sSplit.dfsRootSymTb = sSplit.dfsMain->SymTb;
+  BOOST_REQUIRE(sSplit.dfsProbe(5ULL) == Solver::DfsProgress::OutOfProbes);
+
+  Solver::DfsTask& busy{*sSplit.dfsMain};
+  sSplit.dfsActiveTasks.push_back(&busy);
+  const size_t frameIdx{Solver::dfsSplittableFrame(busy)};
+  BOOST_REQUIRE(frameIdx < busy.frames.size());
+  const Solver::DfsFrame before{busy.frames[frameIdx]};
+
+  const unique_ptr<Solver::DfsTask> split{sSplit.dfsSplitBusyTask()};
+  BOOST_REQUIRE(split);
+  BOOST_CHECK(sSplit.dfsActiveTasks.size() == 2ULL);
+  BOOST_CHECK(sSplit.dfsBusyWorkers == 1U);
+  BOOST_CHECK(split->firstFrameLength == frameIdx);
+  BOOST_CHECK(split->steps->length() == frameIdx);
+  BOOST_CHECK(split->SymTb[SymbolsTable::CrossingIndexSlot] ==
+              double(frameIdx + 1ULL));
+  BOOST_REQUIRE(split->frames.size() == 1ULL);
+
+  const Solver::DfsFrame &kept{busy.frames[frameIdx]},
+      &taken{split->frames.front()};
+  BOOST_CHECK(kept.nextCfgIdx == before.nextCfgIdx);
+  BOOST_CHECK(!taken.nextCfgIdx);
+  BOOST_CHECK(!taken.allowedCfgs.empty());
+  BOOST_CHECK(taken.allowedCfgs.size() >=
+              kept.allowedCfgs.size() - kept.nextCfgIdx);
+  vector<const MovingConfigOption*> rejoined{kept.allowedCfgs};
+  rejoined.insert(rejoined.end(), taken.allowedCfgs.cbegin(),
+                  taken.allowedCfgs.cend());
+  BOOST_CHECK(rejoined == before.allowedCfgs);
+}
+
+BOOST_AUTO_TEST_CASE(dfsProbesBudget_usecases) {
+  using namespace std;
+  using namespace rc;
+  using namespace rc::ent;
+  using namespace rc::sol;
+
+  ScenarioDetails d{comparisonScenario(5U, 2U)};
+
+  // Continuing the DFS after every few probes must not change its outcome
+  const auto checkSameWithBudgets = [&d] {
+    Scenario::Results oDfs;
+    Solver sDfs{d, oDfs};
+    sDfs.run(false);
+    BOOST_REQUIRE(oDfs.attempt);
+
+    for (const size_t probesPerRun : {1ULL, 3ULL, 50ULL}) {
+      Scenario::Results oBudgets;
+      Solver sBudgets{d, oBudgets};
+      unique_ptr<const IState> initSt{d.createInitialState(sBudgets.SymTb)};
+      sBudgets.targetLeftBank =
+          make_unique<const BankEntities>(initSt->rightBank());
+      sBudgets.dfsStart(std::move(initSt));
+
+      Solver::DfsProgress progress{};
+      size_t spentBudgets{};
+      while ((progress = sBudgets.dfsProbe(probesPerRun)) ==
+             Solver::DfsProgress::OutOfProbes)
+        ++spentBudgets;
+      if (probesPerRun == 1ULL)
+        BOOST_CHECK(spentBudgets > 0ULL);
+
+      BOOST_CHECK((progress == Solver::DfsProgress::Solved) ==
+                  oDfs.attempt->isSolution());
+      BOOST_CHECK(sBudgets.steps->toString() == oDfs.attempt->toString());
+      BOOST_CHECK(oBudgets.investigatedStates == oDfs.investigatedStates);
+    }
+
+    // A probes budget of `run` stops the DFS, even when using several threads
+    BOOST_CHECK(!oDfs.interrupted);
+    Scenario::Results oBudget;
+    Solver sBudget{d, oBudget, 4U, 1ULL};
+    sBudget.run(false);
+    BOOST_CHECK(oBudget.interrupted);
+    BOOST_CHECK(oBudget.attempt && !oBudget.attempt->isSolution());
+
+    // The saved DFS continues within another Solver from the same path.
+    // The resumed DFS continues the same path as well
+    for (const size_t probes : {2ULL, 7ULL}) {
+      Scenario::Results oSaved;
+      Solver sSaved{d, oSaved, 1U, probes};
+      sSaved.run(false);
+      if (!oSaved.interrupted)
+        continue;
+
+      ostringstream saved;
+      sSaved.saveDfs(saved);
+      Scenario::Results oLoaded;
+      Solver sLoaded{d, oLoaded};
+      istringstream savedForm{saved.str()};
+      sLoaded.loadDfs(savedForm);
+      BOOST_CHECK(oLoaded.interrupted);
+      BOOST_REQUIRE(oLoaded.attempt);
+      BOOST_CHECK(oLoaded.attempt->toString() == oSaved.attempt->toString());
+
+      ostringstream savedAgain;
+      sLoaded.saveDfs(savedAgain);
+      BOOST_CHECK(savedAgain.str() == saved.str());
+
+      sLoaded.resumeDfs(SIZE_MAX);
+      sSaved.resumeDfs(SIZE_MAX);
+      BOOST_CHECK(!oLoaded.interrupted && !oSaved.interrupted);
+      BOOST_CHECK(oLoaded.attempt->isSolution() ==
+                  oDfs.attempt->isSolution());
+      BOOST_CHECK(oSaved.attempt->toString() == oDfs.attempt->toString());
+      BOOST_CHECK(oSaved.investigatedStates == oDfs.investigatedStates);
+    }
+  };
+
+  // No solution when the raft supports at most a load of 3
+  checkScenarioVariants(d, {3.}, checkSameWithBudgets);
+}
+
+BOOST_AUTO_TEST_CASE(aStar_usecases) {
+  using namespace std;
+  using namespace rc;
+  using namespace rc::ent;
+  using namespace rc::sol;
+
+  ScenarioDetails d{comparisonScenario(6U, 3U)};
+
+  {
+    Scenario::Results o;
+    Solver s{d, o};
+    unique_ptr<const IState> initSt{d.createInitialState(s.SymTb)};
+    s.targetLeftBank = make_unique<const BankEntities>(initSt->rightBank());
+    const auto [minMoved, maxMoved] = s.movingCfgsManager.configsSizesRange();
+    BOOST_REQUIRE(minMoved == 1ULL && maxMoved == 3ULL);
+
+    // 6 entities to move, 3 at a time and someone has to return each time
+    BOOST_CHECK(s.crossingsLowerBound(*initSt) == 5ULL);
+
+    // Just 3 entities left to move
+    const State almostDone{BankEntities{d.entities, {1U, 2U, 3U}},
+                           BankEntities{d.entities, {4U, 5U, 6U}}, true,
+                           DefStateExt::SHARED_INST()};
+    BOOST_CHECK(s.crossingsLowerBound(almostDone) == 1ULL);
+
+    // The raft is on the other bank, so someone needs to come back first.
+    // That one leaves only 2 free places on the raft for the next crossing
+    const State raftAway{BankEntities{d.entities, {1U, 2U, 3U}},
+                         BankEntities{d.entities, {4U, 5U, 6U}}, false,
+                         DefStateExt::SHARED_INST()};
+    BOOST_CHECK(s.crossingsLowerBound(raftAway) == 4ULL);
+
+    const State done{BankEntities{d.entities, {}},
+                     BankEntities{d.entities, {1U, 2U, 3U, 4U, 5U, 6U}}, false,
+                     DefStateExt::SHARED_INST()};
+    BOOST_CHECK(s.crossingsLowerBound(done) == 0ULL);
+  }
+
+  // A* must find solutions as short as those of BFS
+  const auto checkSameLengthAsBfs = [&d] {
+    Scenario::Results oAStar;
+    Solver sAStar{d, oAStar};
+    sAStar.run(Scenario::Algorithm::AStar);
+    const BfsOutcome bfs{bfsOutcome(d)};
+    BOOST_REQUIRE(oAStar.attempt);
+    BOOST_CHECK(oAStar.attempt->isSolution() == bfs.solved);
+    if (bfs.solved)
+      BOOST_CHECK(oAStar.attempt->length() == bfs.solutionLength);
+  };
+
+  // Some raft configurations are too heavy for the max load
+  checkScenarioVariants(d, {8.}, checkSameLengthAsBfs);
+}
+
+BOOST_AUTO_TEST_CASE(bidirectionalBfs_usecases) {
+  using namespace std;
+  using namespace rc;
+  using namespace rc::ent;
+  using namespace rc::cond;
+  using namespace rc::sol;
+
+  ScenarioDetails d{comparisonScenario(5U, 2U, /*reversibleMoves = */ true)};
+
+  // The bidirectional BFS must find solutions as short as those of BFS
+  const auto checkSameLengthAsBfs = [&d] {
+    Scenario::Results oBidir;
+    Solver sBidir{d, oBidir};
+    BOOST_REQUIRE(
+        sBidir.bidirectionalBfsApplicable(*d.createInitialState(sBidir.SymTb)));
+    sBidir.run(Scenario::Algorithm::BidirectionalBFS);
+    const BfsOutcome bfs{bfsOutcome(d)};
+    BOOST_REQUIRE(oBidir.attempt);
+    BOOST_CHECK(oBidir.attempt->isSolution() == bfs.solved);
+    if (bfs.solved)
+      BOOST_CHECK(oBidir.attempt->length() == bfs.solutionLength);
+  };
+
+  // No solution when the raft supports at most a load of 5
+  checkScenarioVariants(d, {5.}, checkSameLengthAsBfs);
+
+  // Time-aware states are not reversible
+  d.maxDuration = 100U;
+  Scenario::Results o;
+  Solver s{d, o};
+  BOOST_CHECK(!s.bidirectionalBfsApplicable(*d.createInitialState(s.SymTb)));
+
+  // Entities rowing only for some values of CrossingIndex
+  auto pAe2{make_unique<AllEntities>()};
+  try {
+    *pAe2 += make_shared<const Entity>(1U, "a", "", false,
+                                       "if (%CrossingIndex% mod 2) in {0}");
+    *pAe2 += make_shared<const Entity>(2U, "b", "", false, "true");
+    *pAe2 += make_shared<const Entity>(3U, "c", "", false, "false");
+  } catch (...) {
+    BOOST_REQUIRE(false);  // Unexpected exception
+  }
+  ScenarioDetails d2;
+  d2.entities = shared_ptr<const AllEntities>(pAe2.release());
+  d2.capacity = 2U;
+  d2.transferConstraints = make_unique<const TransferConstraints>(
+      grammar::ConstraintsVec{}, *d2.entities, d2.capacity, false);
+  Scenario::Results o2;
+  Solver s2{d2, o2};
+  BOOST_CHECK(!s2.bidirectionalBfsApplicable(*d2.createInitialState(s2.SymTb)));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 #endif  // for CPP_SOLVER and UNIT_TESTING